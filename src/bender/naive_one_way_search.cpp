@@ -1,60 +1,79 @@
 #include "naive_one_way_search.hpp"
 
-void NaiveOneWaySearch::detect_new_scc(const VertexPtr& current,
+std::optional<VertexPtr> NaiveOneWaySearch::next_neighbour(
+    const Visit& current, NeighbourList::iterator& neighbour) {
+    auto neighbours = graph.get_neighbours(current.vertex);
+    const auto repr = find_representative_vertex(neighbour.id());
+    // Remove loop / duplicated edge.
+    if (repr == current.vertex ||
+        visited_edge[{current.vertex->id, repr->id}] == current.timestamp) {
+        neighbour = neighbours.erase(neighbour);
+        return std::nullopt;
+    }
+    visited_edge[{current.vertex->id, repr->id}] = current.timestamp;
+    ++neighbour;
+    return repr;
+}
+
+void NaiveOneWaySearch::detect_new_scc(const VertexPtr& source,
                                        const VertexPtr& target) {
-    const auto timestamp = ++traversal_steps_no;
-    visited[current->id] = no_traversals;
-    auto& neighbours = graph.get_neighbours(current);
-    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();) {
-        const auto repr = find_representative_vertex(*neighbour);
-        // Remove loop / duplicated edge.
-        if (repr == current ||
-            visited_edge[{current->id, repr->id}] == timestamp) {
-            neighbour = neighbours.erase(neighbour);
-            continue;
-        }
-        visited_edge[{current->id, repr->id}] = timestamp;
-        ++neighbour;
+    const auto propagate = [this](const Visit& current, const Visit& child) {
+        if (markers.is_marked(child.vertex->id, REACHES_TARGET))
+            markers.mark(current.vertex->id, REACHES_TARGET);
+    };
+
+    markers.mark(source->id, VISITED);
+    dfs_stack.run(
+        enter(source),
+        [this](const Visit& current) {
+            auto neighbours = graph.get_neighbours(current.vertex);
+            return std::pair(neighbours.begin(), neighbours.end());
+        },
+        [&](const Visit& current,
+            NeighbourList::iterator& neighbour) -> std::optional<Visit> {
+            const auto repr = next_neighbour(current, neighbour);
+            if (!repr.has_value())
+                return std::nullopt;
 
-        if (visited[repr->id] != no_traversals) {
-            if (level[repr->id] < level[target->id]) {
-                detect_new_scc(repr, target);
-            } else {
-                if (repr == target) {
-                    reaches_target[repr->id] = no_traversals;
-                    reached_target.emplace_back(repr);
+            if (!markers.is_marked((*repr)->id, VISITED)) {
+                markers.mark((*repr)->id, VISITED);
+                if (level[(*repr)->id] < level[target->id])
+                    return enter(*repr);
+                if (*repr == target) {
+                    markers.mark((*repr)->id, REACHES_TARGET);
+                    reached_target.emplace_back(*repr);
                 }
-                visited[repr->id] = no_traversals;
             }
-        }
 
-        if (reaches_target[repr->id] == no_traversals)
-            reaches_target[current->id] = no_traversals;
-    }
-
-    if (reaches_target[current->id] == no_traversals)
-        reached_target.emplace_back(current);
+            if (markers.is_marked((*repr)->id, REACHES_TARGET))
+                markers.mark(current.vertex->id, REACHES_TARGET);
+            return std::nullopt;
+        },
+        propagate,
+        [this](const Visit& current) {
+            if (markers.is_marked(current.vertex->id, REACHES_TARGET))
+                reached_target.emplace_back(current.vertex);
+        });
 }
 
-void NaiveOneWaySearch::update_levels(const VertexPtr& current) {
-    const auto timestamp = ++traversal_steps_no;
-    auto& neighbours = graph.get_neighbours(current);
-    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();) {
-        const auto repr = find_representative_vertex(*neighbour);
-        // Remove loop / duplicated edge.
-        if (repr == current ||
-            visited_edge[{current->id, repr->id}] == timestamp) {
-            neighbour = neighbours.erase(neighbour);
-            continue;
-        }
-        visited_edge[{current->id, repr->id}] = timestamp;
-        ++neighbour;
+void NaiveOneWaySearch::update_levels(const VertexPtr& source) {
+    dfs_stack.run(
+        enter(source),
+        [this](const Visit& current) {
+            auto neighbours = graph.get_neighbours(current.vertex);
+            return std::pair(neighbours.begin(), neighbours.end());
+        },
+        [this](const Visit& current,
+               NeighbourList::iterator& neighbour) -> std::optional<Visit> {
+            const auto repr = next_neighbour(current, neighbour);
+            if (!repr.has_value() ||
+                level[(*repr)->id] > level[current.vertex->id])
+                return std::nullopt;
 
-        if (level[repr->id] <= level[current->id]) {
-            level[repr->id] = level[current->id] + 1;
-            update_levels(repr);
-        }
-    }
+            level[(*repr)->id] = level[current.vertex->id] + 1;
+            return enter(*repr);
+        },
+        [](const Visit&, const Visit&) {}, [](const Visit&) {});
 }
 
 void NaiveOneWaySearch::algorithm_step(VertexPtr u, VertexPtr v) {
@@ -63,7 +82,7 @@ void NaiveOneWaySearch::algorithm_step(VertexPtr u, VertexPtr v) {
     if (level[u->id] < level[v->id] || u == v)
         return;
 
-    no_traversals++;
+    markers.next_epoch();
     detect_new_scc(v, u);
     merge_into_component(reached_target, {&graph});
 
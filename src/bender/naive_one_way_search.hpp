@@ -8,19 +8,36 @@
 #include <unordered_map>
 
 #include "utils/algorithm.hpp"
+#include "utils/epoch_markers.hpp"
 #include "utils/hash.hpp"
+#include "utils/iterative_dfs.hpp"
 
 class NaiveOneWaySearch : public Algorithm {
    private:
+    enum Marker : size_t { VISITED, REACHES_TARGET, NO_MARKERS };
+
     size_t traversal_steps_no = 0;
-    std::vector<size_t> visited;
+    EpochMarkers<NO_MARKERS> markers;
     std::vector<size_t> level;
-    std::vector<size_t> reaches_target;
     std::vector<VertexPtr> reached_target;
     std::unordered_map<std::pair<Vertex_id_t, Vertex_id_t>, size_t, PairHash>
         visited_edge;
     constexpr static size_t MAX_VISITED_EDGES_SIZE = 15000;
 
+    // Vertex on the DFS stack. Edges of the vertex scanned with the same
+    // timestamp are duplicates.
+    struct Visit {
+        VertexPtr vertex;
+        size_t timestamp;
+    };
+    IterativeDfs<Visit, NeighbourList::iterator> dfs_stack;
+
+    Visit enter(const VertexPtr& u) { return {u, ++traversal_steps_no}; }
+    // Advances `neighbour` and returns its representative, or nothing if the
+    // edge was a loop or a duplicate and got erased.
+    std::optional<VertexPtr> next_neighbour(const Visit& current,
+                                            NeighbourList::iterator& neighbour);
+
     void detect_new_scc(const VertexPtr& current, const VertexPtr& target);
     void update_levels(const VertexPtr& current);
 
@@ -30,9 +47,8 @@ class NaiveOneWaySearch : public Algorithm {
    public:
     explicit NaiveOneWaySearch(size_t no_vertices)
         : Algorithm(no_vertices),
-          visited(no_vertices),
-          level(no_vertices, 1),
-          reaches_target(no_vertices) {}
+          markers(no_vertices),
+          level(no_vertices, 1) {}
 };
 
 #endif  // NAIVE_ONE_WAY_SEARCH_HPP
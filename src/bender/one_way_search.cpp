@@ -29,31 +29,52 @@ size_t OneWaySearch::log_2_floor(size_t x) {
     return static_cast<size_t>(std::log2(x));
 }
 
-void OneWaySearch::find_component_dfs(Vertex_id_t current_id,
+void OneWaySearch::find_component_dfs(Vertex_id_t source_id,
                                       Vertex_id_t u_id) {
-    for (const auto& [out_level, neighbour_id] : heap[current_id].get_out()) {
-        if (out_level >= level[current_id])
-            break;
-        if (neighbour_id == u_id) {
-            if (marked_within_component[u_id] != no_traversals) {
-                marked_within_component[u_id] = no_traversals;
-                component.push_back(graph.get_vertex_by_id(u_id));
+    const auto propagate = [this](Vertex_id_t current_id,
+                                  Vertex_id_t neighbour_id) {
+        if (marked_within_component.is_marked(neighbour_id))
+            marked_within_component.mark(current_id);
+    };
+
+    dfs_stack.run(
+        source_id,
+        [this](Vertex_id_t current_id) {
+            const auto& out = heap[current_id].get_out();
+            return std::pair(out.cbegin(), out.cend());
+        },
+        [&](Vertex_id_t current_id,
+            Heap::Out_vertices_t::const_iterator& out_iter)
+            -> std::optional<Vertex_id_t> {
+            const auto [out_level, neighbour_id] = *out_iter;
+            if (out_level >= level[current_id]) {
+                out_iter = heap[current_id].get_out().cend();
+                return std::nullopt;
+            }
+            ++out_iter;
+
+            if (neighbour_id == u_id) {
+                if (!marked_within_component.is_marked(u_id)) {
+                    marked_within_component.mark(u_id);
+                    component.push_back(graph.get_vertex_by_id(u_id));
+                }
+            } else if (level[neighbour_id] < level[current_id]) {
+                level[neighbour_id] = level[current_id];
+                return neighbour_id;
             }
-        } else if (level[neighbour_id] < level[current_id]) {
-            level[neighbour_id] = level[current_id];
-            find_component_dfs(neighbour_id, u_id);
-        }
-
-        if (marked_within_component[neighbour_id] == no_traversals)
-            marked_within_component[current_id] = no_traversals;
-    }
 
-    if (marked_within_component[current_id] == no_traversals)
-        component.push_back(graph.get_vertex_by_id(current_id));
+            propagate(current_id, neighbour_id);
+            return std::nullopt;
+        },
+        propagate,
+        [this](Vertex_id_t current_id) {
+            if (marked_within_component.is_marked(current_id))
+                component.push_back(graph.get_vertex_by_id(current_id));
+        });
 }
 
 void OneWaySearch::find_component(const VertexPtr& u, const VertexPtr& v) {
-    no_traversals++;
+    marked_within_component.next_epoch();
     level[v->id] = level[u->id] + 1;
     find_component_dfs(v->id, u->id);
 }
@@ -124,7 +145,7 @@ void OneWaySearch::merge_into_component(
 
 std::vector<Raw_edge_t> OneWaySearch::form_component_and_fill_candidates(
     const VertexPtr& u, const VertexPtr& v) {
-    if (marked_within_component[v->id] != no_traversals)
+    if (!marked_within_component.is_marked(v->id))
         return {{u->id, v->id}};
 
     merge_into_component(component);
@@ -176,7 +197,7 @@ void OneWaySearch::algorithm_step(VertexPtr u, VertexPtr v) {
 
     find_component(u, v);
     auto candidates = form_component_and_fill_candidates(u, v);
-    if (marked_within_component[v->id] != no_traversals)
+    if (!marked_within_component.is_marked(v->id))
         insert_edge(u, v);
     while (!candidates.empty())
         traversal_step(candidates);
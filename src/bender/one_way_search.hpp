@@ -8,14 +8,17 @@
 #include <unordered_map>
 
 #include "utils/algorithm.hpp"
+#include "utils/epoch_markers.hpp"
+#include "utils/iterative_dfs.hpp"
 
 using Level_t = size_t;
 
 // Simulates heap called `out(x)` in the paper.
 class Heap {
-   private:
+   public:
     using Out_vertices_t = std::set<std::pair<Level_t, Vertex_id_t>>;
 
+   private:
     Out_vertices_t out;
     // For each neighbour v stores a pointer to v within out.
     std::unordered_map<Vertex_id_t, Out_vertices_t::iterator> pointers;
@@ -56,11 +59,12 @@ class OneWaySearch : public Algorithm {
     std::vector<BST> bst_in, bst_out;
     std::vector<Heap> heap;
     std::vector<VertexPtr> component;
-    std::vector<size_t> marked_within_component;
+    EpochMarkers<1> marked_within_component;
+    IterativeDfs<Vertex_id_t, Heap::Out_vertices_t::const_iterator> dfs_stack;
 
     static size_t log_2_floor(size_t x);
 
-    void find_component_dfs(Vertex_id_t current_id, Vertex_id_t u_id);
+    void find_component_dfs(Vertex_id_t source_id, Vertex_id_t u_id);
     void find_component(const VertexPtr& u, const VertexPtr& v);
 
     void insert_edge(const VertexPtr& u, const VertexPtr& v);
@@ -2,6 +2,20 @@
 
 #include <queue>
 
+VertexPtr TwoWaySearch::add_vertex() {
+    const auto u = Algorithm::add_vertex();
+    markers.add_element();
+    update_vertices_threshold();
+    return u;
+}
+
+void TwoWaySearch::update_vertices_threshold() {
+    const auto cbrt_no_vertices =
+        cbrt(static_cast<double>(graph.get_no_vertices()));
+    vertices_threshold =
+        static_cast<size_t>(cbrt_no_vertices * cbrt_no_vertices);
+}
+
 void TwoWaySearch::update_threshold() {
     // As stated in the paper, we only try to adjust the threshold if the number
     // of edges is a power of 2.
@@ -17,34 +31,35 @@ void TwoWaySearch::update_threshold() {
 }
 
 void TwoWaySearch::search_backward(const VertexPtr& u, const VertexPtr& v) {
-    no_traversals++;
-    visited[u->id] = no_traversals;
+    markers.next_epoch();
+    markers.mark(u->id, VISITED);
     std::queue<VertexPtr> to_be_considered;
     to_be_considered.push(u);
 
     while (!to_be_considered.empty()) {
         const auto current = to_be_considered.front();
         to_be_considered.pop();
-        no_traversal_steps++;
-        considered_during_traversal[current->id] = no_traversal_steps;
+        markers.next_epoch(CONSIDERED);
+        markers.mark(current->id, CONSIDERED);
 
-        auto& neighbours = reversed_graph.get_neighbours(current);
+        auto neighbours = reversed_graph.get_neighbours(current);
         for (auto neighbour = neighbours.begin();
              neighbour != neighbours.end();) {
-            const auto repr = find_representative_vertex(*neighbour);
+            prefetch_next_neighbour(neighbour, markers);
+            const auto repr_id = find_representative_id(neighbour.id());
 
             // Remove loop / duplicated edge.
-            if (considered_during_traversal[repr->id] == no_traversal_steps) {
+            if (markers.is_marked(repr_id, CONSIDERED)) {
                 neighbour = neighbours.erase(neighbour);
                 continue;
             }
 
-            considered_during_traversal[repr->id] = no_traversal_steps;
-            if (repr == v) {
+            markers.mark(repr_id, CONSIDERED);
+            if (repr_id == v->id) {
                 found_cycle = true;
-            } else if (visited[repr->id] != no_traversals) {
-                visited[repr->id] = no_traversals;
-                to_be_considered.push(repr);
+            } else if (!markers.is_marked(repr_id, VISITED)) {
+                markers.mark(repr_id, VISITED);
+                to_be_considered.push(graph.get_vertex_by_id(repr_id));
             }
             edges_used_backwards++;
             if (edges_used_backwards == threshold)
@@ -55,38 +70,40 @@ void TwoWaySearch::search_backward(const VertexPtr& u, const VertexPtr& v) {
 }
 
 void TwoWaySearch::search_forward(const VertexPtr& u) {
+    const auto u_level = level(u->id);
     std::vector<VertexPtr> to_be_considered;
     to_be_considered.push_back(u);
 
     while (!to_be_considered.empty()) {
         const auto current = to_be_considered.back();
         to_be_considered.pop_back();
-        no_traversal_steps++;
-        considered_during_traversal[current->id] = no_traversal_steps;
+        markers.next_epoch(CONSIDERED);
+        markers.mark(current->id, CONSIDERED);
 
-        auto& neighbours = graph.get_neighbours(current);
+        auto neighbours = graph.get_neighbours(current);
         for (auto neighbour = neighbours.begin();
              neighbour != neighbours.end();) {
-            const auto repr = find_representative_vertex(*neighbour);
+            prefetch_next_neighbour(neighbour, markers);
+            const auto repr_id = find_representative_id(neighbour.id());
 
             // Remove loop / duplicated edge.
-            if (considered_during_traversal[repr->id] == no_traversal_steps) {
+            if (markers.is_marked(repr_id, CONSIDERED)) {
                 neighbour = neighbours.erase(neighbour);
                 continue;
             }
 
-            considered_during_traversal[repr->id] = no_traversal_steps;
-            if (visited[repr->id] == no_traversals) {
+            markers.mark(repr_id, CONSIDERED);
+            if (markers.is_marked(repr_id, VISITED)) {
                 found_cycle = true;
             }
 
-            if (level[repr->id] == level[u->id]) {
-                reversed_graph.add_edge(repr, current);
-            } else if (level[repr->id] < level[u->id]) {
-                level[repr->id] = level[u->id];
-                reversed_graph.clean_vertex(repr);
-                reversed_graph.add_edge(repr, current);
-                to_be_considered.push_back(repr);
+            if (level(repr_id) == u_level) {
+                reversed_graph.add_edge_by_id(repr_id, current->id, false);
+            } else if (level(repr_id) < u_level) {
+                level(repr_id) = u_level;
+                reversed_graph.clean_vertex_by_id(repr_id);
+                reversed_graph.add_edge_by_id(repr_id, current->id, false);
+                to_be_considered.push_back(graph.get_vertex_by_id(repr_id));
             }
 
             ++neighbour;
@@ -94,44 +111,56 @@ void TwoWaySearch::search_forward(const VertexPtr& u) {
     }
 }
 
-void TwoWaySearch::form_component_dfs(const VertexPtr& u) {
-    visited[u->id] = no_traversals;
-    auto& neighbours = reversed_graph.get_neighbours(u);
-
-    // We have to remove loops and duplicated edges first,
-    // because we want to use recursive dfs procedure.
-    no_traversal_steps++;
-    considered_during_traversal[u->id] = no_traversal_steps;
-    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();) {
-        const auto repr = find_representative_vertex(*neighbour);
-
-        if (considered_during_traversal[repr->id] == no_traversal_steps) {
-            neighbour = neighbours.erase(neighbour);
-        } else {
-            considered_during_traversal[repr->id] = no_traversal_steps;
-            ++neighbour;
-        }
-    }
-
-    for (auto& neighbour : neighbours) {
-        const auto repr = find_representative_vertex(neighbour);
-
-        if (marked_within_component[repr->id] != no_traversals &&
-            visited[repr->id] != no_traversals)
-            form_component_dfs(repr);
-        if (marked_within_component[repr->id] == no_traversals) {
-            marked_within_component[u->id] = no_traversals;
+void TwoWaySearch::form_component_dfs(const VertexPtr& source) {
+    const auto propagate = [this](const VertexPtr& u, const VertexPtr& repr) {
+        if (markers.is_marked(repr->id, MARKED_WITHIN_COMPONENT)) {
+            markers.mark(u->id, MARKED_WITHIN_COMPONENT);
             component.push_back(u);
         }
-    }
+    };
+
+    dfs_stack.run(
+        source,
+        [this](const VertexPtr& u) {
+            markers.mark(u->id, VISITED);
+            auto neighbours = reversed_graph.get_neighbours(u);
+
+            // We have to remove loops and duplicated edges first, because
+            // entering the neighbours resets CONSIDERED markers.
+            markers.next_epoch(CONSIDERED);
+            markers.mark(u->id, CONSIDERED);
+            for (auto neighbour = neighbours.begin();
+                 neighbour != neighbours.end();) {
+                const auto repr = find_representative_vertex(neighbour.id());
+
+                if (markers.is_marked(repr->id, CONSIDERED)) {
+                    neighbour = neighbours.erase(neighbour);
+                } else {
+                    markers.mark(repr->id, CONSIDERED);
+                    ++neighbour;
+                }
+            }
+            return std::pair(neighbours.begin(), neighbours.end());
+        },
+        [&](const VertexPtr& u,
+            NeighbourList::iterator& neighbour) -> std::optional<VertexPtr> {
+            const auto repr = find_representative_vertex((neighbour++).id());
+
+            if (!markers.is_marked(repr->id, MARKED_WITHIN_COMPONENT) &&
+                !markers.is_marked(repr->id, VISITED))
+                return repr;
+            propagate(u, repr);
+            return std::nullopt;
+        },
+        propagate, [](const VertexPtr&) {});
 }
 
 void TwoWaySearch::form_component(const VertexPtr& u, const VertexPtr& v) {
     if (!found_cycle)
         return;
 
-    no_traversals++;
-    marked_within_component[v->id] = no_traversals;
+    markers.next_epoch();
+    markers.mark(v->id, MARKED_WITHIN_COMPONENT);
     component = {v};
     form_component_dfs(u);
     merge_into_component(component, {&graph, &reversed_graph});
@@ -140,23 +169,23 @@ void TwoWaySearch::form_component(const VertexPtr& u, const VertexPtr& v) {
 void TwoWaySearch::algorithm_step(VertexPtr u, VertexPtr v) {
     u = find_representative_vertex(u);
     v = find_representative_vertex(v);
-    if (u == v || level[u->id] < level[v->id])
+    if (u == v || level(u->id) < level(v->id))
         return;
 
     found_cycle = false;
     edges_used_backwards = 0;
     search_backward(u, v);
     if (edges_used_backwards != threshold) {
-        if (level[v->id] == level[u->id]) {
+        if (level(v->id) == level(u->id)) {
             form_component(u, v);
             return;
         }
-        level[v->id] = level[u->id];
+        level(v->id) = level(u->id);
     } else {
-        level[v->id] = level[u->id] + 1;
+        level(v->id) = level(u->id) + 1;
         // Clever way to properly track 'backward' vertices from the algorithm.
-        no_traversals++;
-        visited[u->id] = no_traversals;
+        markers.next_epoch();
+        markers.mark(u->id, VISITED);
     }
 
     reversed_graph.clean_vertex(v);
@@ -164,6 +193,22 @@ void TwoWaySearch::algorithm_step(VertexPtr u, VertexPtr v) {
     form_component(u, v);
 }
 
+bool TwoWaySearch::insert_without_search(const VertexPtr& u,
+                                         const VertexPtr& v) {
+    const auto u_level = level(find_representative_id(u->id));
+    if (u_level > level(find_representative_id(v->id))) {
+        // Levels never decrease, so only a sink can be moved up to u.
+        if (!is_sink(v->id))
+            return false;
+        level(v->id) = u_level;
+        reversed_graph.clean_vertex(v);
+    }
+
+    preprocess_edge(u, v);
+    postprocess_edge(u, v);
+    return true;
+}
+
 void TwoWaySearch::preprocess_edge(VertexPtr, VertexPtr) {
     no_edges++;
     update_threshold();
@@ -172,9 +217,6 @@ void TwoWaySearch::preprocess_edge(VertexPtr, VertexPtr) {
 void TwoWaySearch::postprocess_edge(VertexPtr u, VertexPtr v) {
     u = find_representative_vertex(u);
     v = find_representative_vertex(v);
-    if (u != v) {
-        graph.add_edge(u, v);
-        if (level[u->id] == level[v->id])
-            reversed_graph.add_edge(v, u);
-    }
+    if (u != v)
+        graph.add_edge(u, v, level(u->id) == level(v->id));
 }
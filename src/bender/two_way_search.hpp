@@ -7,47 +7,63 @@
 #include <cmath>
 
 #include "utils/algorithm.hpp"
+#include "utils/epoch_markers.hpp"
+#include "utils/iterative_dfs.hpp"
 
 class TwoWaySearch : public Algorithm {
    private:
+    // CONSIDERED markers are reset for every processed vertex.
+    enum Marker : size_t {
+        VISITED,
+        MARKED_WITHIN_COMPONENT,
+        CONSIDERED,
+        NO_MARKERS
+    };
+
     size_t no_edges = 0;
-    size_t no_traversal_steps = 0;
     size_t threshold = 1;
     size_t vertices_threshold;
     size_t edges_used_backwards{};
     bool found_cycle{};
     Graph reversed_graph;
-    std::vector<size_t> visited;
-    std::vector<size_t> level;
-    std::vector<size_t> considered_during_traversal;
+    // Levels are stored next to the markers, as both are read for every
+    // scanned edge.
+    EpochMarkers<NO_MARKERS, size_t> markers;
     std::vector<VertexPtr> component;
-    std::vector<size_t> marked_within_component;
+    IterativeDfs<VertexPtr, NeighbourList::iterator> dfs_stack;
+
+    size_t& level(Vertex_id_t vertex_id) { return markers.payload(vertex_id); }
 
     void update_threshold();
+    void update_vertices_threshold();
 
     void search_backward(const VertexPtr& u, const VertexPtr& v);
     void search_forward(const VertexPtr& u);
 
     void form_component(const VertexPtr& u, const VertexPtr& v);
-    void form_component_dfs(const VertexPtr& u);
+    void form_component_dfs(const VertexPtr& source);
 
     void preprocess_edge(VertexPtr, VertexPtr) override;
     void postprocess_edge(VertexPtr u, VertexPtr v) override;
     void algorithm_step(VertexPtr u, VertexPtr v) override;
+    bool insert_without_search(const VertexPtr& u, const VertexPtr& v) override;
+    // Levels don't decrease along edges.
+    std::vector<Vertex_id_t> get_locality_order() override {
+        return sort_representatives([this](Vertex_id_t id) {
+            return level(id);
+        });
+    }
 
    public:
     explicit TwoWaySearch(size_t no_vertices)
         : Algorithm(no_vertices),
-          reversed_graph(graph),
-          visited(no_vertices),
-          level(no_vertices),
-          considered_during_traversal(no_vertices),
-          component(no_vertices),
-          marked_within_component(no_vertices) {
-        const auto cbrt_no_vertices = cbrt(static_cast<double>(no_vertices));
-        vertices_threshold =
-            static_cast<size_t>(cbrt_no_vertices * cbrt_no_vertices);
+          reversed_graph(graph.reversed()),
+          markers(no_vertices),
+          component(no_vertices) {
+        update_vertices_threshold();
     }
+
+    VertexPtr add_vertex() override;
 };
 
 #endif  // TWO_WAY_SEARCH_HPP
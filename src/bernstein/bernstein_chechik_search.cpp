@@ -0,0 +1,190 @@
+#include "bernstein_chechik_search.hpp"
+
+#include <algorithm>
+
+void BernsteinChechikSearch::on_components_merged(Vertex_id_t new_repr_id,
+                                                  Vertex_id_t old_repr_id) {
+    component_graph.move_neighbours_by_id(old_repr_id, new_repr_id);
+    reversed_component_graph.move_neighbours_by_id(old_repr_id, new_repr_id);
+}
+
+void BernsteinChechikSearch::reach(const VertexPtr& x, const VertexPtr& stop,
+                                   Graph& g, std::vector<Frame>& stack,
+                                   std::vector<VertexPtr>& reached) {
+    reached.push_back(x);
+    if (x == stop)
+        return;
+    auto neighbours = g.get_neighbours(x);
+    stack.push_back({x, neighbours, neighbours.begin()});
+}
+
+void BernsteinChechikSearch::search_forward_step(const VertexPtr& u) {
+    auto& frame = forward_stack.back();
+    if (frame.next == frame.neighbours.end()) {
+        forward_stack.pop_back();
+        return;
+    }
+
+    prefetch_next_neighbour(frame.next, markers);
+    const auto current_id = frame.vertex->id;
+    const auto next_id = find_representative_id(frame.next.id());
+    if (next_id == current_id) {
+        frame.next = frame.neighbours.erase(frame.next);
+        return;
+    }
+    ++frame.next;
+    // All successors of u occur after it.
+    const auto& partitions = partitions_handler.get_partitions();
+    if (partitions[next_id] != partitions[current_id] ||
+        order->is_before(u->id, next_id))
+        return;
+
+    const auto next = graph.get_vertex_by_id(next_id);
+    scc_detector.add_edge(frame.vertex, next);
+    if (!markers.is_marked(next_id, VISITED_FORWARD)) {
+        markers.mark(next_id, VISITED_FORWARD);
+        reach(next, u, component_graph, forward_stack, forward_reached);
+    }
+}
+
+void BernsteinChechikSearch::search_backward_step(const VertexPtr& v) {
+    auto& frame = backward_stack.back();
+    if (frame.next == frame.neighbours.end()) {
+        backward_stack.pop_back();
+        return;
+    }
+
+    prefetch_next_neighbour(frame.next, markers);
+    const auto current_id = frame.vertex->id;
+    const auto previous_id = find_representative_id(frame.next.id());
+    if (previous_id == current_id) {
+        frame.next = frame.neighbours.erase(frame.next);
+        return;
+    }
+    ++frame.next;
+    // All predecessors of v occur before it.
+    const auto& partitions = partitions_handler.get_partitions();
+    if (partitions[previous_id] != partitions[current_id] ||
+        order->is_before(previous_id, v->id))
+        return;
+
+    const auto previous = graph.get_vertex_by_id(previous_id);
+    scc_detector.add_edge(previous, frame.vertex);
+    if (!markers.is_marked(previous_id, VISITED_BACKWARD)) {
+        markers.mark(previous_id, VISITED_BACKWARD);
+        reach(previous, v, reversed_component_graph, backward_stack,
+              backward_reached);
+    }
+}
+
+bool BernsteinChechikSearch::search(const VertexPtr& u, const VertexPtr& v) {
+    markers.next_epoch();
+    markers.mark(v->id, VISITED_FORWARD);
+    reach(v, u, component_graph, forward_stack, forward_reached);
+    markers.mark(u->id, VISITED_BACKWARD);
+    reach(u, v, reversed_component_graph, backward_stack, backward_reached);
+
+    while (true) {
+        if (forward_stack.empty())
+            return true;
+        search_forward_step(u);
+        if (backward_stack.empty())
+            return false;
+        search_backward_step(v);
+    }
+}
+
+void BernsteinChechikSearch::move_next_to(const std::vector<VertexPtr>& reached,
+                                          const VertexPtr& anchor,
+                                          bool after) {
+    // Moving a vertex doesn't change the relative order of the remaining ones,
+    // so keys computed up front stay comparable.
+    keyed_reached.clear();
+    for (const auto& vertex : reached) {
+        if (vertex != anchor && find_representative_vertex(vertex) == vertex)
+            keyed_reached.emplace_back(order->order_key(vertex->id),
+                                       vertex->id);
+    }
+    std::sort(keyed_reached.begin(), keyed_reached.end());
+
+    // Each vertex is inserted right after the previous one, so that
+    // consecutive insertions don't split the same gap of labels over and over.
+    std::optional<Vertex_id_t> previous_id;
+    for (const auto& [_, vertex_id] : keyed_reached) {
+        order->remove(vertex_id);
+        if (previous_id.has_value())
+            order->insert_after(vertex_id, *previous_id);
+        else if (after)
+            order->insert_after(vertex_id, anchor->id);
+        else
+            order->insert_before(vertex_id, anchor->id);
+        previous_id = vertex_id;
+    }
+}
+
+void BernsteinChechikSearch::algorithm_step(VertexPtr u, VertexPtr v) {
+    if (update_partitions(u, v))
+        return;
+
+    u = find_representative_vertex(u);
+    v = find_representative_vertex(v);
+    if (u == v || order->is_before(u->id, v->id))
+        return;
+
+    // Now u and v belong to the same partition, as partitions occupy
+    // consecutive segments of the order. Vertices which have to be moved
+    // are related to u or v, so they belong to this partition as well.
+    // Either all vertices reachable from v are moved after u, or all vertices
+    // reaching u are moved before v, whichever search finishes first.
+    const auto forward_finished = search(u, v);
+    scc_detector.find_new_connected_component(v, u, new_scc);
+    for (size_t i = 1; i < new_scc.size(); i++) {
+        const auto union_result =
+            find_union.union_elements(new_scc[i - 1]->id, new_scc[i]->id);
+        if (union_result.has_value())
+            on_components_merged(union_result->new_representative,
+                                 union_result->merged_away);
+    }
+
+    // The new component takes the place of the vertex which isn't moved.
+    const auto anchor = forward_finished ? u : v;
+    const auto component_representant = find_representative_vertex(anchor);
+    compact_neighbours_if_needed(component_graph, component_representant);
+    compact_neighbours_if_needed(reversed_component_graph,
+                                 component_representant);
+    if (component_representant != anchor) {
+        order->remove(component_representant->id);
+        order->insert_after(component_representant->id, anchor->id);
+    }
+    for (const auto& vertex : new_scc) {
+        if (vertex != component_representant)
+            order->remove(vertex->id);
+    }
+
+    if (forward_finished)
+        move_next_to(forward_reached, component_representant, true);
+    else
+        move_next_to(backward_reached, component_representant, false);
+}
+
+void BernsteinChechikSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
+    PartitionedSearch::postprocess_edge(u, v);
+    const auto u_repr = find_representative_vertex(u);
+    const auto v_repr = find_representative_vertex(v);
+    if (u_repr != v_repr)
+        component_graph.add_edge(u_repr, v_repr);
+
+    forward_stack.clear();
+    backward_stack.clear();
+    forward_reached.clear();
+    backward_reached.clear();
+    scc_detector.clear();
+    new_scc.clear();
+}
+
+VertexPtr BernsteinChechikSearch::add_vertex() {
+    const auto u = PartitionedSearch::add_vertex();
+    component_graph.add_vertex(u);
+    markers.add_element();
+    return u;
+}
@@ -0,0 +1,81 @@
+#ifndef BERNSTEIN_CHECHIK_SEARCH_HPP
+#define BERNSTEIN_CHECHIK_SEARCH_HPP
+
+/// Implements algorithm from the paper by A. Bernstein and S. Chechik:
+/// "Incremental Topological Sort and Cycle Detection in ~O(m * sqrt(n))
+/// Expected Total Time", extended to maintain strongly connected components.
+/// The degree bound assumed by the paper is provided by running it on a graph
+/// sparsified with AdvancedGraphSparsifier (see Sparsified).
+
+#include "sample_search.hpp"
+#include "utils/epoch_markers.hpp"
+#include "utils/scc_detector.hpp"
+
+class BernsteinChechikSearch : public PartitionedSearch {
+   private:
+    enum Marker : size_t { VISITED_FORWARD, VISITED_BACKWARD, NO_MARKERS };
+
+    // Sampled reachability is propagated between single vertices, so `graph`
+    // keeps edges at their original endpoints. Searches run on copies where
+    // edges of a component are moved to its representative.
+    Graph component_graph;
+    Graph reversed_component_graph;
+    EpochMarkers<NO_MARKERS> markers;
+    // Vertices whose edges are being scanned, with the next edge to scan.
+    struct Frame {
+        VertexPtr vertex;
+        NeighbourList neighbours;
+        NeighbourList::iterator next;
+    };
+    std::vector<Frame> forward_stack;
+    std::vector<Frame> backward_stack;
+    std::vector<VertexPtr> forward_reached;
+    std::vector<VertexPtr> backward_reached;
+    std::vector<std::pair<Order_key_t, Vertex_id_t>> keyed_reached;
+    // Used to determine newly created strongly connected components.
+    SccDetector scc_detector;
+    std::vector<VertexPtr> new_scc;
+
+    // Both searches visit only vertices of the partition of u and v, which
+    // occur between v and u in the order. Each step scans a single edge, so
+    // a component with a long list doesn't stall the other search.
+    void search_forward_step(const VertexPtr &u);
+    void search_backward_step(const VertexPtr &v);
+    // Marks x as reached and, unless it's where the search stops, schedules
+    // scanning its edges in `g`.
+    static void reach(const VertexPtr &x, const VertexPtr &stop, Graph &g,
+                      std::vector<Frame> &stack,
+                      std::vector<VertexPtr> &reached);
+    // Alternates steps of both searches until one of them finishes. Returns
+    // if it was the forward one.
+    bool search(const VertexPtr &u, const VertexPtr &v);
+
+    // Moves canonical vertices of `reached` next to `anchor`, keeping their
+    // relative order.
+    void move_next_to(const std::vector<VertexPtr> &reached,
+                      const VertexPtr &anchor, bool after);
+
+   protected:
+    void on_components_merged(Vertex_id_t new_repr_id,
+                              Vertex_id_t old_repr_id) override;
+
+    void algorithm_step(VertexPtr u, VertexPtr v) override;
+    void postprocess_edge(VertexPtr u, VertexPtr v) override;
+
+   public:
+    BernsteinChechikSearch(size_t no_vertices, DynamicOrderPtr order,
+                           std::optional<size_t> sample_size =
+                               AlgorithmOptions::
+                                   DEFAULT_BERNSTEIN_CHECHIK_SAMPLE_SIZE,
+                           std::optional<size_t> original_no_vertices =
+                               std::nullopt)
+        : PartitionedSearch(no_vertices, std::move(order), sample_size,
+                            original_no_vertices),
+          component_graph(graph),
+          reversed_component_graph(component_graph.reversed()),
+          markers(no_vertices) {}
+
+    VertexPtr add_vertex() override;
+};
+
+#endif  // BERNSTEIN_CHECHIK_SEARCH_HPP
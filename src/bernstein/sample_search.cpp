@@ -1,5 +1,7 @@
 #include "sample_search.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 
 #include "utils/rng.hpp"
@@ -11,147 +13,299 @@ bool contains(const std::vector<Vertex_id_t>& ids, const Vertex_id_t id) {
 }
 }  // namespace
 
-void SampledVertexTraversal::dfs(
-    const VertexPtr& start, const SampledVertexTraversal& other_traversal) {
-    std::vector stack = {start};
-    visited[start->id] = true;
+bool SampledReachability::add_pending(Vertex_id_t v_id,
+                                      const Mask_word_t* bits) {
+    const auto* v_mask = mask_of(v_id);
+    auto* v_pending = pending_of(v_id);
+    bool was_pending = false;
+    bool is_pending = false;
+    for (size_t i = 0; i < no_words; i++) {
+        was_pending |= v_pending[i] != 0;
+        v_pending[i] |= bits[i] & ~v_mask[i];
+        is_pending |= v_pending[i] != 0;
+    }
+    return !was_pending && is_pending;
+}
+
+void SampledReachability::reserve_samples(size_t sample_size) {
+    const auto new_no_words =
+        (sample_size + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+    if (new_no_words <= no_words)
+        return;
+
+    const auto no_vertices = context->graph.get_no_vertices();
+    std::vector<Mask_word_t> new_masks(no_vertices * new_no_words);
+    for (size_t i = 0; i < no_vertices; i++) {
+        std::copy(mask_of(i), mask_of(i) + no_words,
+                  &new_masks[i * new_no_words]);
+    }
+    masks = std::move(new_masks);
+    // Pending bits are always empty between traversals.
+    pending.assign(masks.size(), 0);
+    delta.resize(new_no_words);
+    no_words = new_no_words;
+}
+
+void SampledReachability::add_vertex() {
+    masks.resize(masks.size() + no_words);
+    pending.resize(masks.size());
+}
+
+void SampledReachability::add_root(size_t sample_index, const VertexPtr& root,
+                                   const SampledReachability& other,
+                                   const std::vector<VertexPtr>& roots) {
+    std::fill(delta.begin(), delta.end(), 0);
+    delta[sample_index / MASK_WORD_BITS] |= Mask_word_t{1}
+                                            << (sample_index % MASK_WORD_BITS);
+    if (!add_pending(root->id, delta.data()))
+        return;
+
+    // Vertices reachable both from and to the root already belong to its
+    // strongly connected component, so they are not reported.
+    stack.emplace_back(root);
+    propagate(other, roots, false);
+}
+
+void SampledReachability::search_for_new_reachable(
+    const VertexPtr& u, const VertexPtr& v, const SampledReachability& other,
+    const std::vector<VertexPtr>& roots) {
+    if (!add_pending(v->id, mask_of(u->id)))
+        return;
+
+    stack.emplace_back(v);
+    propagate(other, roots, true);
+}
+
+void SampledReachability::propagate(const SampledReachability& other,
+                                    const std::vector<VertexPtr>& roots,
+                                    bool report_new_scc) {
     while (!stack.empty()) {
         const auto current = stack.back();
         stack.pop_back();
-        if (other_traversal.visited[current->id]) {
-            context->new_scc->emplace_back(current);
-            context->new_scc->emplace_back(root);
+
+        auto* current_mask = mask_of(current->id);
+        auto* current_pending = pending_of(current->id);
+        const auto* other_mask = other.mask_of(current->id);
+        size_t no_new_reached = 0;
+        for (size_t i = 0; i < no_words; i++) {
+            delta[i] = current_pending[i] & ~current_mask[i];
+            current_pending[i] = 0;
+            current_mask[i] |= delta[i];
+            no_new_reached += std::popcount(delta[i]);
+            if (!report_new_scc)
+                continue;
+
+            // Sampled vertices both reaching and reachable from `current`.
+            for (auto both = delta[i] & other_mask[i]; both; both &= both - 1) {
+                const auto sample_index =
+                    i * MASK_WORD_BITS + std::countr_zero(both);
+                context->new_scc->emplace_back(current);
+                context->new_scc->emplace_back(roots[sample_index]);
+            }
         }
+        if (no_new_reached == 0)
+            continue;
+
         if (context->reached_counter[current->id] == 0)
             context->reached->emplace_back(current);
-        context->reached_counter[current->id]++;
+        context->reached_counter[current->id] += no_new_reached;
         for (const auto& neighbour : context->graph.get_neighbours(current)) {
-            if (!visited[neighbour->id]) {
-                visited[neighbour->id] = true;
+            if (add_pending(neighbour->id, delta.data()))
                 stack.emplace_back(neighbour);
-            }
         }
     }
 }
 
-void SampledVertexTraversal::search_for_new_reachable(
-    const VertexPtr& u, const VertexPtr& v,
-    const SampledVertexTraversal& other_traversal) {
-    if (visited[u->id] && !visited[v->id])
-        dfs(v, other_traversal);
-}
-
-void SampledVertex::update_reachable(const VertexPtr& u, const VertexPtr& v) {
-    forward.search_for_new_reachable(u, v, backward);
-    backward.search_for_new_reachable(v, u, forward);
-}
-
 // We use Theorem 27 and sample vertices independently.
 Sample::Sample(Graph& graph, std::optional<size_t> original_no_vertices,
                const SampleTraversalContextPtr& forward_context,
-               const SampleTraversalContextPtr& backward_context) {
-    auto no_vertices = graph.get_no_vertices();
-    if (original_no_vertices.has_value())
-        no_vertices = *original_no_vertices;
-    std::set<size_t> picked_ids;
-    while (picked_ids.size() < std::min(no_vertices, SAMPLE_SIZE)) {
+               const SampleTraversalContextPtr& backward_context,
+               std::optional<size_t> sample_size)
+    : graph(graph),
+      no_vertices(original_no_vertices.value_or(graph.get_no_vertices())),
+      adaptive(!sample_size.has_value()),
+      forward(forward_context, sample_size.value_or(MIN_ADAPTIVE_SIZE)),
+      backward(backward_context, sample_size.value_or(MIN_ADAPTIVE_SIZE)) {
+    const auto initial_size =
+        std::min(no_vertices, sample_size.value_or(MIN_ADAPTIVE_SIZE));
+    while (picked_ids.size() < initial_size) {
         picked_ids.insert(
             RNG::instance().randint(0, static_cast<int>(no_vertices) - 1));
     }
 
-    for (auto& id : picked_ids)
-        sampled_vertices.emplace_back(graph.get_vertex_by_id(id),
-                                      forward_context, backward_context);
+    for (const auto& id : picked_ids)
+        add_sampled_vertex(id);
+}
+
+void Sample::add_sampled_vertex(Vertex_id_t id) {
+    const auto root = graph.get_vertex_by_id(id);
+    roots.emplace_back(root);
+    forward.add_root(roots.size() - 1, root, backward, roots);
+    backward.add_root(roots.size() - 1, root, forward, roots);
+}
+
+void Sample::adapt_size() {
+    const auto target_size = std::min(
+        no_vertices,
+        std::clamp(static_cast<size_t>(std::ceil(
+                       std::cbrt(static_cast<double>(no_processed_edges)))),
+                   MIN_ADAPTIVE_SIZE, MAX_ADAPTIVE_SIZE));
+    if (roots.size() >= target_size)
+        return;
+
+    forward.reserve_samples(target_size);
+    backward.reserve_samples(target_size);
+    while (roots.size() < target_size) {
+        const auto id = static_cast<Vertex_id_t>(
+            RNG::instance().randint(0, static_cast<int>(no_vertices) - 1));
+        if (picked_ids.insert(id).second)
+            add_sampled_vertex(id);
+    }
 }
 
-size_t Sample::size() const { return sampled_vertices.size(); }
+size_t Sample::size() const { return roots.size(); }
+
+void Sample::add_vertex() {
+    forward.add_vertex();
+    backward.add_vertex();
+}
 
 void Sample::process_edge(const VertexPtr& u, const VertexPtr& v) {
-    for (auto& sampled : sampled_vertices)
-        sampled.update_reachable(u, v);
+    if (adaptive) {
+        no_processed_edges++;
+        adapt_size();
+    }
+    forward.search_for_new_reachable(u, v, backward, roots);
+    backward.search_for_new_reachable(v, u, forward, roots);
 }
 
 void PartitionHeaps::clear_modified_heaps() { modified_heaps.clear(); }
 
-void PartitionHeaps::create_empty_set(const Partition& partition) {
-    heaps.emplace(partition, std::set<Vertex_id_t, DynamicOrderComparator>(
-                                 order_comparator));
-}
+void PartitionHeaps::create_empty_set() { buckets.emplace_back(); }
 
-void PartitionHeaps::insert(const Partition& partition, const VertexPtr& u) {
-    if (heaps.at(partition).empty())
-        modified_heaps.emplace_back(partition);
-    heaps.at(partition).insert(u->id);
+void PartitionHeaps::insert(Partition_id_t partition_id, const VertexPtr& u) {
+    if (buckets[partition_id].empty())
+        modified_heaps.emplace_back(partition_id);
+    buckets[partition_id].emplace_back(u->id);
 }
 
 void PartitionHeaps::process_heap(const DynamicOrderPtr& order,
-                                  const Partition& partition,
+                                  Partition_id_t partition_id,
                                   Vertex_id_t dummy_id) {
-    while (!heaps.at(partition).empty()) {
-        const auto vertex_iter = get_best_option(partition);
-        const auto vertex_id = *vertex_iter;
-        heaps.at(partition).erase(vertex_iter);
+    // Moving a vertex doesn't change the relative order of the remaining ones,
+    // so keys computed up front determine the whole processing order.
+    keyed_bucket.clear();
+    for (const auto& vertex_id : buckets[partition_id])
+        keyed_bucket.emplace_back(order->order_key(vertex_id), vertex_id);
+    buckets[partition_id].clear();
+
+    std::sort(keyed_bucket.begin(), keyed_bucket.end());
+    keyed_bucket.erase(
+        std::unique(keyed_bucket.begin(), keyed_bucket.end()),
+        keyed_bucket.end());
+
+    // Each vertex is inserted right after the previous one rather than next
+    // to the dummy node, so that consecutive insertions don't split the same
+    // gap of labels over and over.
+    std::optional<Vertex_id_t> previous_id;
+    for (const auto& [_, vertex_id] : keyed_bucket) {
         order->remove(vertex_id);
-        update_order(order, vertex_id, dummy_id);
+        if (previous_id.has_value())
+            order->insert_after(vertex_id, *previous_id);
+        else
+            insert_next_to_dummy(order, vertex_id, dummy_id);
+        previous_id = vertex_id;
     }
 }
 
-PartitionHeaps::Heap_iterator PartitionHeapsUp::get_best_option(
-    const Partition& partition) {
-    return --heaps.at(partition).end();
-}
-
-PartitionHeaps::Heap_iterator PartitionHeapsDown::get_best_option(
-    const Partition& partition) {
-    return heaps.at(partition).begin();
-}
-
-void PartitionHeapsUp::update_order(const DynamicOrderPtr& order,
-                                    Vertex_id_t vertex_id,
-                                    Vertex_id_t dummy_id) {
+void PartitionHeapsUp::insert_next_to_dummy(const DynamicOrderPtr& order,
+                                            Vertex_id_t vertex_id,
+                                            Vertex_id_t dummy_id) {
     order->insert_after(vertex_id, dummy_id);
 }
 
-void PartitionHeapsDown::update_order(const DynamicOrderPtr& order,
-                                      Vertex_id_t vertex_id,
-                                      Vertex_id_t dummy_id) {
+void PartitionHeapsDown::insert_next_to_dummy(const DynamicOrderPtr& order,
+                                              Vertex_id_t vertex_id,
+                                              Vertex_id_t dummy_id) {
     order->insert_before(vertex_id, dummy_id);
 }
 
 std::pair<Vertex_id_t, Vertex_id_t> PartitionsHandler::get_dummy_ids(
-    const Partition& partition) const {
-    return {dummy_ids.at(partition), dummy_ids.at(partition) + 1};
+    Partition_id_t partition_id) const {
+    return {dummy_ids[partition_id], dummy_ids[partition_id] + 1};
 }
 
 std::optional<Partition> PartitionsHandler::next_dummy(
     const Partition& partition) {
-    const auto iter = dummy_ids.upper_bound(partition);
-    if (iter == dummy_ids.end())
+    const auto iter = ordered_partitions.upper_bound(partition);
+    if (iter == ordered_partitions.end())
         return std::nullopt;
-    return iter->first;
+    return *iter;
 }
 
-void PartitionsHandler::insert_dummy(const Partition& partition) {
-    if (dummy_ids.contains(partition))
-        return;
+Partition_id_t PartitionsHandler::insert_dummy(const Partition& partition) {
+    const auto [iter, inserted] =
+        partition_ids.try_emplace(partition, dummy_ids.size());
+    if (!inserted)
+        return iter->second;
 
+    const auto partition_id = iter->second;
     const auto dummy_id_front = order->total_elements_capacity();
     const auto dummy_id_back = dummy_id_front + 1;
-    dummy_ids.emplace(partition, dummy_id_front);
+    dummy_ids.emplace_back(dummy_id_front);
+    dummy_partition_ids.emplace(dummy_id_front, partition_id);
+    ordered_partitions.insert(partition);
     order->extend_elements_capacity();
     order->extend_elements_capacity();
 
-    up.create_empty_set(partition);
-    down.create_empty_set(partition);
+    up.create_empty_set();
+    down.create_empty_set();
 
     const auto next_partition = next_dummy(partition);
     if (!next_partition.has_value())
         order->insert_back(dummy_id_front);
     else
-        order->insert_before(dummy_id_front,
-                             get_dummy_ids(*next_partition).first);
+        order->insert_before(
+            dummy_id_front,
+            get_dummy_ids(partition_ids.at(*next_partition)).first);
 
     order->insert_after(dummy_id_back, dummy_id_front);
+    return partition_id;
+}
+
+void PartitionsHandler::release_id(Vertex_id_t id) {
+    auto iter = dummy_partition_ids.find(id);
+    if (iter == dummy_partition_ids.end() && id > 0)
+        iter = dummy_partition_ids.find(id - 1);
+    if (iter == dummy_partition_ids.end())
+        return;
+
+    const auto partition_id = iter->second;
+    const auto [old_id_front, old_id_back] = get_dummy_ids(partition_id);
+    dummy_partition_ids.erase(iter);
+
+    const auto dummy_id_front = order->total_elements_capacity();
+    dummy_ids[partition_id] = dummy_id_front;
+    dummy_partition_ids.emplace(dummy_id_front, partition_id);
+    order->extend_elements_capacity();
+    order->extend_elements_capacity();
+
+    const auto [new_id_front, new_id_back] = get_dummy_ids(partition_id);
+    order->insert_before(new_id_front, old_id_front);
+    order->remove(old_id_front);
+    order->insert_before(new_id_back, old_id_back);
+    order->remove(old_id_back);
+}
+
+void PartitionsHandler::add_vertex(Vertex_id_t vertex_id) {
+    release_id(vertex_id);
+    while (order->total_elements_capacity() <= vertex_id)
+        order->extend_elements_capacity();
+
+    partitions.emplace_back();
+    const auto [_, dummy_id_back] =
+        get_dummy_ids(partition_ids.at(Partition{}));
+    order->insert_before(vertex_id, dummy_id_back);
 }
 
 void PartitionsHandler::fill_up_and_down(
@@ -171,26 +325,27 @@ void PartitionsHandler::fill_up_and_down(
             old_partition.ancestors_no + new_ancestors_no,
             old_partition.descendants_no + new_descendants_no};
         partitions[u->id] = new_partition;
-        insert_dummy(new_partition);
+        const auto partition_id = insert_dummy(new_partition);
 
         if (new_partition < old_partition)
-            down.insert(new_partition, u);
+            down.insert(partition_id, u);
         else
-            up.insert(new_partition, u);
+            up.insert(partition_id, u);
     }
 }
 
 void PartitionsHandler::process_up_and_down() {
-    for (const auto& partition : up.get_modified_heaps())
-        up.process_heap(order, partition, get_dummy_ids(partition).first);
+    for (const auto& partition_id : up.get_modified_heaps())
+        up.process_heap(order, partition_id, get_dummy_ids(partition_id).first);
     up.clear_modified_heaps();
 
-    for (const auto& partition : down.get_modified_heaps())
-        down.process_heap(order, partition, get_dummy_ids(partition).second);
+    for (const auto& partition_id : down.get_modified_heaps())
+        down.process_heap(order, partition_id,
+                          get_dummy_ids(partition_id).second);
     down.clear_modified_heaps();
 }
 
-void SampleSearch::remove_non_canonical_reached_from_sampled() {
+void PartitionedSearch::remove_non_canonical_reached_from_sampled() {
     for (size_t i = 0; i < forward_context->reached->size();) {
         const auto u = forward_context->reached->at(i);
         if (find_representative_vertex(u) != u) {
@@ -203,55 +358,97 @@ void SampleSearch::remove_non_canonical_reached_from_sampled() {
     }
 }
 
-void SampleSearch::merge_scc_containing_sampled() {
+void PartitionedSearch::merge_scc_containing_sampled() {
     const auto new_scc = forward_context->new_scc;
     for (size_t i = 1; i < new_scc->size(); i++) {
         const auto union_result = find_union.union_elements(
             new_scc->at(i - 1)->id, new_scc->at(i)->id);
         if (union_result.has_value()) {
-            const auto [_, old_repr_id] = *union_result;
+            const auto [new_repr_id, old_repr_id] = *union_result;
             order->remove(old_repr_id);
+            on_components_merged(new_repr_id, old_repr_id);
         }
     }
 }
 
-std::vector<size_t> Explorer::status;
-size_t Explorer::no_explorations;
+bool PartitionedSearch::update_partitions(const VertexPtr& u,
+                                          const VertexPtr& v) {
+    sample.process_edge(u, v);
+    remove_non_canonical_reached_from_sampled();
+    partitions_handler.fill_up_and_down(forward_context, backward_context);
+    partitions_handler.process_up_and_down();
+    merge_scc_containing_sampled();
+    return !forward_context->new_scc->empty();
+}
+
+void PartitionedSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
+    graph.add_edge(u, v);
+
+    forward_context->reached->clear();
+    forward_context->new_scc->clear();
+}
+
+VertexPtr PartitionedSearch::add_vertex() {
+    const auto u = Algorithm::add_vertex();
+    forward_context->reached_counter.emplace_back();
+    backward_context->reached_counter.emplace_back();
+    sample.add_vertex();
+    partitions_handler.add_vertex(u->id);
+    return u;
+}
 
-bool Explorer::alive_or_dead(Vertex_id_t vertex_id) const {
-    return alive.contains(vertex_id) || dead.contains(vertex_id);
+void ExplorerHeap::push(const Entry& entry) {
+    entries.push_back(entry);
+    std::push_heap(
+        entries.begin(), entries.end(),
+        [this](const Entry& a, const Entry& b) { return below(a, b); });
 }
 
-std::optional<Vertex_id_t> Explorer::get_minimum_from_heap(
-    const Vertex_heap& heap) {
-    if (heap.empty())
-        return std::nullopt;
-    return *heap.begin();
+void ExplorerHeap::pop() {
+    std::pop_heap(
+        entries.begin(), entries.end(),
+        [this](const Entry& a, const Entry& b) { return below(a, b); });
+    entries.pop_back();
 }
 
-std::optional<Vertex_id_t> Explorer::get_maximum_from_heap(
-    const Vertex_heap& heap) {
-    if (heap.empty())
-        return std::nullopt;
-    return *(--heap.end());
+EpochMarkers<1> Explorer::status;
+
+ExplorerHeap::Entry Explorer::make_entry(Vertex_id_t vertex_id) const {
+    return {order->order_key(find_union.find_representant(vertex_id)),
+            vertex_id};
+}
+
+void Explorer::insert_dead(const ExplorerHeap::Entry& entry) {
+    if (is_dead(entry.vertex_id))
+        return;
+    markers.mark(entry.vertex_id, DEAD);
+    dead.push(entry);
+}
+
+void Explorer::drop_erased_dead() {
+    while (!dead.empty() && !is_dead(dead.top().vertex_id))
+        dead.pop();
 }
 
 std::vector<Vertex_id_t> Explorer::get_dead_as_vector() {
-    std::vector<Vertex_id_t> dead_vec = {dead.begin(), dead.end()};
+    std::vector<Vertex_id_t> dead_vec;
+    for (const auto& entry : dead.get_entries()) {
+        if (is_dead(entry.vertex_id))
+            dead_vec.emplace_back(entry.vertex_id);
+    }
     dead.clear();
+    markers.next_epoch(DEAD);
     return dead_vec;
 }
 
 void Explorer::populate_dead_with_vector(
     const std::vector<Vertex_id_t>& dead_vec) {
     for (const auto& u_id : dead_vec)
-        dead.insert(find_union.find_representant(u_id));
+        insert_dead(make_entry(find_union.find_representant(u_id)));
 }
 
 void Explorer::erase_from_dead(Vertex_id_t vertex_id) {
-    const auto iter = dead.find(find_union.find_representant(vertex_id));
-    if (iter != dead.end())
-        dead.erase(iter);
+    markers.unmark(find_union.find_representant(vertex_id), DEAD);
 }
 
 bool Explorer::any_alive() {
@@ -261,38 +458,56 @@ bool Explorer::any_alive() {
 }
 
 void Explorer::add_alive(Vertex_id_t vertex_id) {
-    visited_scc[find_union.find_representant(vertex_id)] = no_explorations;
-    alive.insert(vertex_id);
+    markers.mark(find_union.find_representant(vertex_id), VISITED_SCC);
+    if (is_alive(vertex_id))
+        return;
+    markers.mark(vertex_id, ALIVE);
+    alive.push(make_entry(vertex_id));
 }
 
-std::optional<Vertex_id_t> Explorer::get_maximum_dead() const {
-    return get_maximum_from_heap(dead);
+std::optional<Vertex_id_t> Explorer::get_best_alive_option() const {
+    if (alive.empty())
+        return std::nullopt;
+    return alive.top().vertex_id;
 }
 
-std::optional<Vertex_id_t> Explorer::get_minimum_dead() const {
-    return get_minimum_from_heap(dead);
+std::optional<Vertex_id_t> Explorer::get_best_dead_option() {
+    drop_erased_dead();
+    if (dead.empty())
+        return std::nullopt;
+    return dead.top().vertex_id;
 }
 
-void Explorer::explore(Vertex_id_t vertex_id, const Explorer& other_explorer) {
-    const auto vertex = graph.get_vertex_by_id(vertex_id);
-    const auto repr_id = find_union.find_representant(vertex_id);
-    alive.erase(vertex_id);
-    dead.insert(vertex_id);
+void Explorer::explore(const Explorer& other_explorer) {
+    const auto entry = alive.top();
+    alive.pop();
+    markers.unmark(entry.vertex_id, ALIVE);
+    insert_dead(entry);
 
-    for (const auto& neighbour : graph.get_neighbours(vertex)) {
+    const auto vertex = graph.get_vertex_by_id(entry.vertex_id);
+    const auto repr_id = find_union.find_representant(entry.vertex_id);
+    auto neighbours = graph.get_neighbours(vertex);
+    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();
+         ++neighbour) {
+        const auto neighbour_id = neighbour.id();
         const auto neighbour_repr_id =
-            find_union.find_representant(neighbour->id);
+            find_union.find_representant(neighbour_id);
         if (partitions[repr_id] == partitions[neighbour_repr_id]) {
-            if (other_explorer.visited_scc[neighbour_repr_id] ==
-                no_explorations)
+            if (other_explorer.markers.is_marked(neighbour_repr_id,
+                                                 VISITED_SCC))
                 cycle_created = true;
-            if (!alive_or_dead(neighbour->id))
-                add_alive(neighbour->id);
+            if (!is_alive(neighbour_id) && !is_dead(neighbour_id))
+                add_alive(neighbour_id);
         }
     }
 }
 
-void Explorer::increase_explorations_no() { no_explorations++; }
+void Explorer::start_exploration() {
+    status.next_epoch();
+    for (const auto marker :
+         {VISITED_SCC, VISITED, MARKED, REORDERED_COMPONENT})
+        markers.next_epoch(marker);
+}
 
 bool Explorer::process_best_alive_option(Explorer& other_explorer,
                                          const DynamicOrderPtr& order) {
@@ -314,43 +529,63 @@ bool Explorer::process_best_alive_option(Explorer& other_explorer,
         }
     }
 
-    status[*x] = no_explorations;
-    explore(*x, other_explorer);
+    status.mark(*x);
+    explore(other_explorer);
     return false;
 }
 
-void Explorer::dfs(const VertexPtr& current,
+void Explorer::dfs(const VertexPtr& source,
                    const std::vector<Vertex_id_t>& permitted_components_ids,
                    std::vector<Vertex_id_t>& marked_canonical_ids) {
-    visited[current->id] = no_explorations;
-    const auto current_repr_id = find_union.find_representant(current->id);
-    bool current_marked = contains(permitted_components_ids, current_repr_id);
-
-    for (const auto& neighbour : graph.get_neighbours(current)) {
+    const auto propagate = [this](const VertexPtr&,
+                                  const VertexPtr& neighbour) {
         const auto neighbour_repr_id =
             find_union.find_representant(neighbour->id);
-        if (status[neighbour->id] == no_explorations) {
-            if (visited[neighbour->id] != no_explorations)
-                dfs(neighbour, permitted_components_ids, marked_canonical_ids);
-            current_marked |= marked[neighbour_repr_id] == no_explorations;
-        } else {
-            current_marked |=
-                contains(permitted_components_ids, neighbour_repr_id);
-        }
-    }
-
-    if (current_marked) {
-        marked_canonical_ids.emplace_back(
-            find_union.find_representant(current->id));
-        marked[current_repr_id] = no_explorations;
-    }
+        if (markers.is_marked(neighbour_repr_id, MARKED))
+            marked_stack.back() = true;
+    };
+
+    dfs_stack.run(
+        source,
+        [&](const VertexPtr& current) {
+            markers.mark(current->id, VISITED);
+            marked_stack.push_back(
+                contains(permitted_components_ids,
+                         find_union.find_representant(current->id)));
+            auto neighbours = graph.get_neighbours(current);
+            return std::pair(neighbours.begin(), neighbours.end());
+        },
+        [&](const VertexPtr& current, NeighbourList::iterator& neighbour_iter)
+            -> std::optional<VertexPtr> {
+            const auto& neighbour = *neighbour_iter++;
+            if (status.is_marked(neighbour->id)) {
+                if (!markers.is_marked(neighbour->id, VISITED))
+                    return neighbour;
+                propagate(current, neighbour);
+            } else if (contains(permitted_components_ids,
+                                find_union.find_representant(neighbour->id))) {
+                marked_stack.back() = true;
+            }
+            return std::nullopt;
+        },
+        propagate,
+        [&](const VertexPtr& current) {
+            const auto current_marked = marked_stack.back();
+            marked_stack.pop_back();
+            if (current_marked) {
+                const auto current_repr_id =
+                    find_union.find_representant(current->id);
+                marked_canonical_ids.emplace_back(current_repr_id);
+                markers.mark(current_repr_id, MARKED);
+            }
+        });
 }
 
 void Explorer::extend_canonical_order(
     Vertex_id_t current_id, std::vector<Vertex_id_t>& new_canonical_order) {
     const auto current_repr_id = find_union.find_representant(current_id);
-    if (reordered_component[current_repr_id] != no_explorations) {
-        reordered_component[current_repr_id] = no_explorations;
+    if (!markers.is_marked(current_repr_id, REORDERED_COMPONENT)) {
+        markers.mark(current_repr_id, REORDERED_COMPONENT);
         new_canonical_order.emplace_back(current_repr_id);
     }
 }
@@ -358,18 +593,21 @@ void Explorer::extend_canonical_order(
 void Explorer::generate_canonical_order(
     Vertex_id_t start_repr_id, std::vector<Vertex_id_t>& new_canonical_order,
     bool update_forward) {
-    reordered_component[start_repr_id] = no_explorations;
+    markers.mark(start_repr_id, REORDERED_COMPONENT);
 
-    if (update_forward) {
-        for (auto current_iter = dead.rbegin(); current_iter != dead.rend();
-             ++current_iter)
-            extend_canonical_order(*current_iter, new_canonical_order);
-    } else {
-        for (const auto& current_iter : dead)
-            extend_canonical_order(current_iter, new_canonical_order);
+    std::vector<ExplorerHeap::Entry> sorted_dead;
+    for (const auto& entry : dead.get_entries()) {
+        if (is_dead(entry.vertex_id))
+            sorted_dead.emplace_back(entry);
     }
+    std::sort(sorted_dead.begin(), sorted_dead.end());
+    if (update_forward)
+        std::reverse(sorted_dead.begin(), sorted_dead.end());
+    for (const auto& entry : sorted_dead)
+        extend_canonical_order(entry.vertex_id, new_canonical_order);
 
     dead.clear();
+    markers.next_epoch(DEAD);
 }
 
 void Explorer::generate_canonical_order(
@@ -385,30 +623,22 @@ void Explorer::generate_canonical_order(
                                             update_forward);
 }
 
+void Explorer::add_vertex() {
+    status.resize(graph.get_no_vertices());
+    // The helper node of the order could have moved.
+    markers.resize(order->total_elements_capacity() + 1);
+}
+
 void Explorer::clear() {
     alive.clear();
+    markers.next_epoch(ALIVE);
     dead.clear();
+    markers.next_epoch(DEAD);
     cycle_created = false;
     pivot_id = std::nullopt;
     finished_processing_alive = false;
 }
 
-std::optional<Vertex_id_t> ForwardExplorer::get_best_alive_option() {
-    return get_minimum_from_heap(alive);
-}
-
-std::optional<Vertex_id_t> ForwardExplorer::get_best_dead_option() {
-    return get_maximum_from_heap(dead);
-}
-
-std::optional<Vertex_id_t> BackwardExplorer::get_best_alive_option() {
-    return get_maximum_from_heap(alive);
-}
-
-std::optional<Vertex_id_t> BackwardExplorer::get_best_dead_option() {
-    return get_minimum_from_heap(dead);
-}
-
 bool ForwardExplorer::current_alive_surpassed_other_best_dead(
     Vertex_id_t current_alive, Vertex_id_t other_best_dead,
     const DynamicOrderPtr& order) {
@@ -422,7 +652,8 @@ bool BackwardExplorer::current_alive_surpassed_other_best_dead(
 }
 
 void SampleSearch::find_component(const VertexPtr& u, const VertexPtr& v) {
-    Explorer::increase_explorations_no();
+    forward_explorer.start_exploration();
+    backward_explorer.start_exploration();
     const auto u_repr = find_representative_vertex(u);
     const auto v_repr = find_representative_vertex(v);
     if (order->is_before(u_repr->id, v_repr->id))
@@ -514,20 +745,15 @@ void SampleSearch::update_order(const VertexPtr& u, const VertexPtr& v,
 
 void SampleSearch::algorithm_step(VertexPtr u, VertexPtr v) {
     // Phase 1 from the paper.
-    sample.process_edge(u, v);
-    remove_non_canonical_reached_from_sampled();
-    partitions_handler.fill_up_and_down(forward_context, backward_context);
-    partitions_handler.process_up_and_down();
-    merge_scc_containing_sampled();
-    if (!forward_context->new_scc->empty())
+    if (update_partitions(u, v))
         return;
 
     // Phase 2 from the paper without point 6c which is moved to the next phase.
     find_component(u, v);
 
     // Phase 3 from the paper.
-    const auto maximum_dead_id = forward_explorer.get_maximum_dead();
-    const auto minimum_dead_id = backward_explorer.get_minimum_dead();
+    const auto maximum_dead_id = forward_explorer.get_best_dead_option();
+    const auto minimum_dead_id = backward_explorer.get_best_dead_option();
     if (!maximum_dead_id.has_value())
         return;
 
@@ -546,11 +772,7 @@ void SampleSearch::algorithm_step(VertexPtr u, VertexPtr v) {
 }
 
 void SampleSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
-    graph.add_edge(u, v);
-    reversed_graph.add_edge(v, u);
-
-    forward_context->reached->clear();
-    forward_context->new_scc->clear();
+    PartitionedSearch::postprocess_edge(u, v);
 
     forward_explorer.clear();
     backward_explorer.clear();
@@ -559,29 +781,15 @@ void SampleSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
     new_canonical_order.clear();
 }
 
-void SparsifiedSampleSearch::run(const Raw_edges_list& edges) {
-    for (const auto& edge : edges) {
-        graph_sparsifier_forward.increase_edges_no();
-        graph_sparsifier_backward.increase_edges_no();
-
-        const auto [u_id, v_id] = edge;
-        const auto u = graph.get_vertex_by_id(u_id);
-        const auto v = graph.get_vertex_by_id(v_id);
-
-        graph_sparsifier_forward.generate_new_edges(u);
-        graph_sparsifier_backward.generate_new_edges(v);
-        graph_sparsifier_forward.insert_generated_edge(
-            graph_sparsifier_forward.get_corresponding_id(u),
-            graph_sparsifier_backward.get_corresponding_id(v));
-
-        for (const auto& [w_id, z_id] :
-             *graph_sparsifier_forward.get_generated_edges()) {
-            const auto w = graph.get_vertex_by_id(w_id);
-            const auto z = graph.get_vertex_by_id(z_id);
-            algorithm_step(w, z);
-            postprocess_edge(w, z);
-        }
-
-        graph_sparsifier_forward.clear_generated_edges();
+VertexPtr SampleSearch::add_vertex() {
+    // The id of the new vertex could be taken by a helper node of the order.
+    if (restore_canonical_order_helper == graph.get_no_vertices()) {
+        restore_canonical_order_helper = order->total_elements_capacity();
+        order->extend_elements_capacity();
     }
+    const auto u = PartitionedSearch::add_vertex();
+
+    forward_explorer.add_vertex();
+    backward_explorer.add_vertex();
+    return u;
 }
@@ -4,12 +4,16 @@
 /// Implements algorithm from https://doi.org/10.4230/LIPIcs.ESA.2021.14.
 /// Works in expected total time ~O(m^(4/3)).
 
-#include <map>
+#include <cstdint>
 #include <set>
+#include <unordered_map>
 
 #include "utils/algorithm.hpp"
+#include "utils/algorithm_options.hpp"
 #include "utils/dynamic_order.hpp"
-#include "utils/graph_sparsifier.hpp"
+#include "utils/epoch_markers.hpp"
+#include "utils/hash.hpp"
+#include "utils/iterative_dfs.hpp"
 
 struct SampleTraversalContext {
     Graph &graph;
@@ -20,59 +24,96 @@ struct SampleTraversalContext {
 
 using SampleTraversalContextPtr = std::shared_ptr<SampleTraversalContext>;
 
-class SampledVertexTraversal {
+// For every vertex keeps a bitmask of sampled vertices reaching it (or
+// reachable from it, for the backward direction). Reachability of all sampled
+// vertices is propagated by a single traversal.
+class SampledReachability {
    private:
-    VertexPtr root;
-    std::vector<bool> visited;
+    using Mask_word_t = uint64_t;
+    static constexpr size_t MASK_WORD_BITS = 64;
+
+    size_t no_words;
+    // Mask of the i-th vertex occupies words [i * no_words, (i + 1) * no_words).
+    std::vector<Mask_word_t> masks;
+    // Bits which still have to be propagated to a vertex. A vertex is on the
+    // stack iff its pending mask is non-empty.
+    std::vector<Mask_word_t> pending;
+    std::vector<Mask_word_t> delta;
+    std::vector<VertexPtr> stack;
     SampleTraversalContextPtr context;
 
-    void dfs(const VertexPtr &start,
-             const SampledVertexTraversal &other_traversal);
-
-   public:
-    SampledVertexTraversal(const VertexPtr &root,
-                           const SampleTraversalContextPtr &context)
-        : root(root), context(context) {
-        const auto no_vertices = context->graph.get_no_vertices();
-        visited.resize(no_vertices);
-        visited[root->id] = true;
-        context->reached->emplace_back(root);
-        context->reached_counter[root->id] = 1;
+    Mask_word_t *mask_of(Vertex_id_t id) { return &masks[id * no_words]; }
+    const Mask_word_t *mask_of(Vertex_id_t id) const {
+        return &masks[id * no_words];
     }
+    Mask_word_t *pending_of(Vertex_id_t id) { return &pending[id * no_words]; }
 
-    void search_for_new_reachable(
-        const VertexPtr &u, const VertexPtr &v,
-        const SampledVertexTraversal &other_traversal);
-};
+    // Adds `bits & ~mask(v)` to pending bits of v. Returns if v has to be
+    // pushed to the stack.
+    bool add_pending(Vertex_id_t v_id, const Mask_word_t *bits);
 
-// Responsible for handling a vertex sampled to set called S in the paper.
-class SampledVertex {
-   private:
-    SampledVertexTraversal forward;
-    SampledVertexTraversal backward;
+    // Processes the stack until all pending bits are propagated.
+    void propagate(const SampledReachability &other,
+                   const std::vector<VertexPtr> &roots, bool report_new_scc);
 
    public:
-    SampledVertex(const VertexPtr &root,
-                  const SampleTraversalContextPtr &forward_context,
-                  const SampleTraversalContextPtr &backward_context)
-        : forward(root, forward_context), backward(root, backward_context) {}
-    ~SampledVertex() = default;
-
-    void update_reachable(const VertexPtr &u, const VertexPtr &v);
+    SampledReachability(const SampleTraversalContextPtr &context,
+                        size_t sample_size)
+        : no_words((sample_size + MASK_WORD_BITS - 1) / MASK_WORD_BITS),
+          masks(context->graph.get_no_vertices() * no_words),
+          pending(masks.size()),
+          delta(no_words),
+          context(context) {}
+
+    // Makes masks able to store `sample_size` sampled vertices.
+    void reserve_samples(size_t sample_size);
+    // Adds an empty mask for a vertex appended to the graph.
+    void add_vertex();
+
+    // Marks all vertices reachable from (or reaching) a new sampled vertex.
+    void add_root(size_t sample_index, const VertexPtr &root,
+                  const SampledReachability &other,
+                  const std::vector<VertexPtr> &roots);
+
+    // Propagates sampled vertices reaching u but not v through the edge (u, v).
+    void search_for_new_reachable(const VertexPtr &u, const VertexPtr &v,
+                                  const SampledReachability &other,
+                                  const std::vector<VertexPtr> &roots);
 };
 
+// Responsible for handling vertices sampled to set called S in the paper.
+// The sample has either a fixed size or grows with the number of processed
+// edges m to clamp(m^(1/3), 2, 256) vertices.
 class Sample {
    private:
-    static constexpr size_t SAMPLE_SIZE = 2;
-    std::vector<SampledVertex> sampled_vertices;
+    static constexpr size_t MIN_ADAPTIVE_SIZE = 2;
+    static constexpr size_t MAX_ADAPTIVE_SIZE = 256;
+
+    Graph &graph;
+    // Vertices with ids smaller than this value can be sampled.
+    size_t no_vertices;
+    bool adaptive;
+    size_t no_processed_edges = 0;
+    std::set<Vertex_id_t> picked_ids;
+    std::vector<VertexPtr> roots;
+    SampledReachability forward;
+    SampledReachability backward;
+
+    void add_sampled_vertex(Vertex_id_t id);
+    void adapt_size();
 
    public:
+    // If `sample_size` is not set, the size is adapted as the stream grows.
     Sample(Graph &graph, std::optional<size_t> original_no_vertices,
            const SampleTraversalContextPtr &forward_context,
-           const SampleTraversalContextPtr &backward_context);
+           const SampleTraversalContextPtr &backward_context,
+           std::optional<size_t> sample_size);
 
     size_t size() const;
 
+    // Vertices appended to the graph are never sampled.
+    void add_vertex();
+
     void process_edge(const VertexPtr &u, const VertexPtr &v);
 };
 
@@ -90,57 +131,63 @@ struct Partition {
     }
 };
 
-// Handles operations on heaps called UP and DOWN in the paper.
+struct PartitionHash {
+    size_t operator()(const Partition &partition) const {
+        size_t seed = 0;
+        hash_combine(seed, partition.ancestors_no);
+        hash_combine(seed, partition.descendants_no);
+        return seed;
+    }
+};
+
+// Dense index of a partition, assigned in order of creation.
+using Partition_id_t = size_t;
+
+// Handles operations on heaps called UP and DOWN in the paper. Vertices of each
+// partition are gathered in a bucket, which is sorted once by order keys when
+// it gets processed.
 class PartitionHeaps {
    protected:
-    using Heap_t = std::set<Vertex_id_t, DynamicOrderComparator>;
-    using Heap_iterator = Heap_t::iterator;
-    DynamicOrderComparator order_comparator;
-    std::map<Partition, Heap_t> heaps;
-    std::vector<Partition> modified_heaps;
+    using Keyed_vertex = std::pair<Order_key_t, Vertex_id_t>;
+    std::vector<std::vector<Vertex_id_t>> buckets;
+    std::vector<Partition_id_t> modified_heaps;
+    std::vector<Keyed_vertex> keyed_bucket;
 
-    virtual Heap_iterator get_best_option(const Partition &partition) = 0;
-    virtual void update_order(const DynamicOrderPtr &order,
-                              Vertex_id_t vertex_id, Vertex_id_t dummy_id) = 0;
+    // Vertices of a heap keep their relative order and are placed right
+    // after the front dummy node (UP) or right before the back one (DOWN).
+    virtual void insert_next_to_dummy(const DynamicOrderPtr &order,
+                                      Vertex_id_t vertex_id,
+                                      Vertex_id_t dummy_id) = 0;
 
    public:
-    explicit PartitionHeaps(const DynamicOrderPtr &order)
-        : order_comparator(order) {}
+    PartitionHeaps() = default;
     virtual ~PartitionHeaps() = default;
 
-    const std::vector<Partition> &get_modified_heaps() const {
+    const std::vector<Partition_id_t> &get_modified_heaps() const {
         return modified_heaps;
     }
 
     void clear_modified_heaps();
 
-    void create_empty_set(const Partition &partition);
-    void insert(const Partition &partition, const VertexPtr &u);
+    void create_empty_set();
+    void insert(Partition_id_t partition_id, const VertexPtr &u);
 
-    void process_heap(const DynamicOrderPtr &order, const Partition &partition,
-                      Vertex_id_t dummy_id);
+    void process_heap(const DynamicOrderPtr &order,
+                      Partition_id_t partition_id, Vertex_id_t dummy_id);
 };
 
 class PartitionHeapsUp : public PartitionHeaps {
    protected:
-    Heap_iterator get_best_option(const Partition &partition) override;
-    void update_order(const DynamicOrderPtr &order, Vertex_id_t vertex_id,
-                      Vertex_id_t dummy_id) override;
-
-   public:
-    explicit PartitionHeapsUp(const DynamicOrderPtr &order)
-        : PartitionHeaps(order) {}
+    void insert_next_to_dummy(const DynamicOrderPtr &order,
+                              Vertex_id_t vertex_id,
+                              Vertex_id_t dummy_id) override;
 };
 
 class PartitionHeapsDown : public PartitionHeaps {
    protected:
-    Heap_iterator get_best_option(const Partition &partition) override;
-    void update_order(const DynamicOrderPtr &order, Vertex_id_t vertex_id,
-                      Vertex_id_t dummy_id) override;
-
-   public:
-    explicit PartitionHeapsDown(const DynamicOrderPtr &order)
-        : PartitionHeaps(order) {}
+    void insert_next_to_dummy(const DynamicOrderPtr &order,
+                              Vertex_id_t vertex_id,
+                              Vertex_id_t dummy_id) override;
 };
 
 // Handles partitions - dummy nodes, sets UP, DOWN described in the paper, etc.
@@ -149,66 +196,134 @@ class PartitionsHandler {
     DynamicOrderPtr order;
     // For each vertex stores its current partition
     std::vector<Partition> partitions;
+    std::unordered_map<Partition, Partition_id_t, PartitionHash> partition_ids;
     // Assumption: for each partition dummy nodes have consecutive ids.
-    std::map<Partition, Vertex_id_t> dummy_ids{};
+    // Stores the id of the first dummy node for each partition.
+    std::vector<Vertex_id_t> dummy_ids;
+    // Inverse of `dummy_ids`.
+    std::unordered_map<Vertex_id_t, Partition_id_t> dummy_partition_ids;
+    // Needed only to find the neighbouring partition of a new one.
+    std::set<Partition> ordered_partitions;
     PartitionHeapsUp up;
     PartitionHeapsDown down;
 
     std::optional<Partition> next_dummy(const Partition &partition);
+    // If `id` is taken by a dummy node, moves both dummy nodes of its
+    // partition to new ids.
+    void release_id(Vertex_id_t id);
 
    public:
     PartitionsHandler(size_t no_vertices, const DynamicOrderPtr &order)
-        : order(order), partitions(no_vertices), up(order), down(order) {
+        : order(order), partitions(no_vertices) {
         // Corner case managed by hand: dummy node for partition (0, 0).
-        insert_dummy({0, 0});
-        const auto dummy_id_front = get_dummy_ids({0, 0}).first;
+        const auto dummy_id_front = get_dummy_ids(insert_dummy({0, 0})).first;
         order->remove(dummy_id_front);
         order->insert_before(dummy_id_front, order->first_element());
     }
 
     const std::vector<Partition> &get_partitions() const { return partitions; }
 
+    // Places a vertex appended to the graph in partition (0, 0).
+    void add_vertex(Vertex_id_t vertex_id);
+
     // For a given partition returns ids of its both dummy nodes.
     std::pair<Vertex_id_t, Vertex_id_t> get_dummy_ids(
-        const Partition &partition) const;
-    void insert_dummy(const Partition &partition);
+        Partition_id_t partition_id) const;
+    // Returns the id of the partition, creating its dummy nodes if needed.
+    Partition_id_t insert_dummy(const Partition &partition);
 
     void fill_up_and_down(const SampleTraversalContextPtr &forward_context,
                           const SampleTraversalContextPtr &backward_context);
     void process_up_and_down();
 };
 
+// Heap of vertices used by Explorer. Vertices are ordered by the position of
+// their representatives in the order, ties are broken by ids. Entries are
+// deleted lazily, membership is tracked by the owner.
+class ExplorerHeap {
+   public:
+    struct Entry {
+        Order_key_t key;
+        Vertex_id_t vertex_id;
+
+        bool operator<(const Entry &other) const {
+            return key < other.key ||
+                   (key == other.key && vertex_id < other.vertex_id);
+        }
+    };
+
+   private:
+    std::vector<Entry> entries;
+    // If true, the last component in the order is at the top of the heap.
+    bool max_at_top;
+
+    // Comparator used by std heap functions, which keep the largest element
+    // at the top.
+    bool below(const Entry &a, const Entry &b) const {
+        return max_at_top ? a < b : b < a;
+    }
+
+   public:
+    explicit ExplorerHeap(bool max_at_top) : max_at_top(max_at_top) {}
+
+    bool empty() const { return entries.empty(); }
+    const Entry &top() const { return entries.front(); }
+    const std::vector<Entry> &get_entries() const { return entries; }
+
+    void push(const Entry &entry);
+    void pop();
+    void clear() { entries.clear(); }
+};
+
 // Used to implement exploring described in the 2nd and 3rd Phase in the paper.
 class Explorer {
    protected:
-    using Vertex_heap = std::set<Vertex_id_t, FindUnionDynamicOrderComparator>;
-    Vertex_heap alive, dead;
+    // ALIVE and DEAD markers are reset whenever the corresponding heap is
+    // cleared, the remaining ones when a new exploration starts.
+    enum Marker : size_t {
+        ALIVE,
+        DEAD,
+        VISITED_SCC,
+        VISITED,
+        MARKED,
+        REORDERED_COMPONENT,
+        NO_MARKERS
+    };
+
+    DynamicOrderPtr order;
+    ExplorerHeap alive, dead;
     Graph &graph;
     const std::vector<Partition> &partitions;
     const FindUnion &find_union;
     bool cycle_created = false;
-    static std::vector<size_t> status;
-    std::vector<size_t> visited_scc;
-    static size_t no_explorations;
-    std::vector<size_t> visited;
-    std::vector<size_t> marked;
+    // Shared by both explorers.
+    static EpochMarkers<1> status;
+    // Also indexed by the helper node of the order.
+    EpochMarkers<NO_MARKERS> markers;
+    IterativeDfs<VertexPtr, NeighbourList::iterator> dfs_stack;
+    // For each vertex on the stack of `dfs` stores whether it has to be
+    // marked.
+    std::vector<bool> marked_stack;
     // Needed to check condition from the 6th step of Phase 2.
     std::optional<Vertex_id_t> pivot_id = std::nullopt;
     // Needed to know whether to run UpdateForward or UpdateBackward later.
     bool finished_processing_alive = false;
-    std::vector<size_t> reordered_component;
-
-    bool alive_or_dead(Vertex_id_t vertex_id) const;
 
-    void explore(Vertex_id_t vertex_id, const Explorer &other_explorer);
+    bool is_alive(Vertex_id_t vertex_id) const {
+        return markers.is_marked(vertex_id, ALIVE);
+    }
+    bool is_dead(Vertex_id_t vertex_id) const {
+        return markers.is_marked(vertex_id, DEAD);
+    }
+    ExplorerHeap::Entry make_entry(Vertex_id_t vertex_id) const;
+    void insert_dead(const ExplorerHeap::Entry &entry);
+    // Removes entries of vertices which are no longer dead from the top.
+    void drop_erased_dead();
 
-    static std::optional<Vertex_id_t> get_minimum_from_heap(
-        const Vertex_heap &heap);
-    static std::optional<Vertex_id_t> get_maximum_from_heap(
-        const Vertex_heap &heap);
+    // Moves the best alive vertex to dead ones and explores it.
+    void explore(const Explorer &other_explorer);
 
-    virtual std::optional<Vertex_id_t> get_best_alive_option() = 0;
-    virtual std::optional<Vertex_id_t> get_best_dead_option() = 0;
+    std::optional<Vertex_id_t> get_best_alive_option() const;
 
     virtual bool current_alive_surpassed_other_best_dead(
         Vertex_id_t current_alive, Vertex_id_t other_best_dead,
@@ -222,24 +337,26 @@ class Explorer {
                                   bool update_forward);
 
    public:
+    // Forward explorer needs the first alive and the last dead vertex,
+    // backward one the other way round.
     Explorer(const DynamicOrderPtr &order, Graph &graph,
              const std::vector<Partition> &partitions,
-             const FindUnion &find_union)
-        : alive(FindUnionDynamicOrderComparator(order, find_union)),
-          dead(FindUnionDynamicOrderComparator(order, find_union)),
+             const FindUnion &find_union, bool forward)
+        : order(order),
+          alive(!forward),
+          dead(forward),
           graph(graph),
           partitions(partitions),
           find_union(find_union),
-          visited_scc(graph.get_no_vertices()),
-          visited(graph.get_no_vertices()),
-          marked(graph.get_no_vertices()),
-          reordered_component(order->total_elements_capacity() + 1) {
-        status.resize(graph.get_no_vertices());
-        no_explorations = 0;
+          markers(order->total_elements_capacity() + 1) {
+        status = EpochMarkers<1>(graph.get_no_vertices());
     }
 
     virtual ~Explorer() = default;
 
+    // Extends per-vertex data with a vertex appended to the graph.
+    void add_vertex();
+
     bool cycle_found() const { return cycle_created; }
     std::optional<Vertex_id_t> get_pivot_id() const { return pivot_id; }
     bool get_finished_processing_alive() const {
@@ -247,21 +364,25 @@ class Explorer {
     }
 
     std::vector<Vertex_id_t> get_dead_as_vector();
+    // Keys of the order are recomputed, as the order could have changed.
     void populate_dead_with_vector(const std::vector<Vertex_id_t> &dead_vec);
     void erase_from_dead(Vertex_id_t vertex_id);
 
     bool any_alive();
     void add_alive(Vertex_id_t vertex_id);
-    std::optional<Vertex_id_t> get_maximum_dead() const;
-    std::optional<Vertex_id_t> get_minimum_dead() const;
+    // Returns the last dead vertex in the order for the forward explorer and
+    // the first one for the backward explorer.
+    std::optional<Vertex_id_t> get_best_dead_option();
 
-    static void increase_explorations_no();
+    // Resets markers of the previous exploration, has to be called for both
+    // explorers.
+    void start_exploration();
 
     // Returns if loop processing alive options should be terminated.
     bool process_best_alive_option(Explorer &other_explorer,
                                    const DynamicOrderPtr &order);
 
-    void dfs(const VertexPtr &current,
+    void dfs(const VertexPtr &source,
              const std::vector<Vertex_id_t> &permitted_components_ids,
              std::vector<Vertex_id_t> &marked_canonical_ids);
 
@@ -278,9 +399,6 @@ class Explorer {
 
 class ForwardExplorer : public Explorer {
    protected:
-    std::optional<Vertex_id_t> get_best_alive_option() override;
-    std::optional<Vertex_id_t> get_best_dead_option() override;
-
     bool current_alive_surpassed_other_best_dead(
         Vertex_id_t current_alive, Vertex_id_t other_best_dead,
         const DynamicOrderPtr &order) override;
@@ -289,14 +407,11 @@ class ForwardExplorer : public Explorer {
     ForwardExplorer(const DynamicOrderPtr &order, Graph &graph,
                     const std::vector<Partition> &partitions,
                     const FindUnion &find_union)
-        : Explorer(order, graph, partitions, find_union) {}
+        : Explorer(order, graph, partitions, find_union, true) {}
 };
 
 class BackwardExplorer : public Explorer {
    protected:
-    std::optional<Vertex_id_t> get_best_alive_option() override;
-    std::optional<Vertex_id_t> get_best_dead_option() override;
-
     bool current_alive_surpassed_other_best_dead(
         Vertex_id_t current_alive, Vertex_id_t other_best_dead,
         const DynamicOrderPtr &order) override;
@@ -305,42 +420,40 @@ class BackwardExplorer : public Explorer {
     BackwardExplorer(const DynamicOrderPtr &order, Graph &graph,
                      const std::vector<Partition> &partitions,
                      const FindUnion &find_union)
-        : Explorer(order, graph, partitions, find_union) {}
+        : Explorer(order, graph, partitions, find_union, false) {}
 };
 
-class SampleSearch : public Algorithm {
-   private:
+// Phase 1 from the paper, shared with BernsteinChechikSearch: maintains the
+// sample and keeps vertices grouped by partitions in the order. An edge whose
+// endpoints end up in the wrong order afterwards connects two vertices of the
+// same partition.
+class PartitionedSearch : public Algorithm {
+   protected:
     Graph reversed_graph;
     SampleTraversalContextPtr forward_context;
     SampleTraversalContextPtr backward_context;
     Sample sample;
     DynamicOrderPtr order;
     PartitionsHandler partitions_handler;
-    ForwardExplorer forward_explorer;
-    BackwardExplorer backward_explorer;
-    std::vector<Vertex_id_t> new_scc_canonical_ids;
-    std::vector<Vertex_id_t> new_canonical_order;
-    Vertex_id_t restore_canonical_order_helper;
 
     void remove_non_canonical_reached_from_sampled();
     void merge_scc_containing_sampled();
+    // Called after the component of `old_repr_id` got merged into the one of
+    // `new_repr_id`.
+    virtual void on_components_merged(Vertex_id_t, Vertex_id_t) {}
 
-    void find_component(const VertexPtr &u, const VertexPtr &v);
-
-    void unionize_and_remove_non_canonical(Vertex_id_t start_id);
-    // Execute UpdateForward / UpdateBackward from the 3rd Phase.
-    void update_order(const VertexPtr &u, const VertexPtr &v,
-                      bool update_forward);
+    // Returns if the edge created a strongly connected component containing
+    // a sampled vertex, which is already merged.
+    bool update_partitions(const VertexPtr &u, const VertexPtr &v);
 
-   protected:
     void postprocess_edge(VertexPtr u, VertexPtr v) override;
-    void algorithm_step(VertexPtr u, VertexPtr v) override;
 
    public:
-    SampleSearch(size_t no_vertices, DynamicOrderPtr order,
-                 std::optional<size_t> original_no_vertices = std::nullopt)
+    PartitionedSearch(size_t no_vertices, DynamicOrderPtr order,
+                      std::optional<size_t> sample_size,
+                      std::optional<size_t> original_no_vertices)
         : Algorithm(no_vertices),
-          reversed_graph(graph),
+          reversed_graph(graph.reversed()),
           // Context objects will have a shared `reached` and `new_scc` vectors.
           forward_context(
               std::make_shared<SampleTraversalContext>(SampleTraversalContext{
@@ -352,37 +465,52 @@ class SampleSearch : public Algorithm {
                   reversed_graph, forward_context->reached,
                   std::vector<size_t>(no_vertices), forward_context->new_scc})),
           sample(graph, original_no_vertices, forward_context,
-                 backward_context),
+                 backward_context, sample_size),
           order(std::move(order)),
-          partitions_handler(no_vertices, this->order),
-          forward_explorer(this->order, graph,
-                           partitions_handler.get_partitions(), find_union),
-          backward_explorer(this->order, reversed_graph,
-                            partitions_handler.get_partitions(), find_union) {
-        restore_canonical_order_helper = this->order->total_elements_capacity();
-        this->order->extend_elements_capacity();
+          partitions_handler(no_vertices, this->order) {
         partitions_handler.fill_up_and_down(forward_context, backward_context);
         partitions_handler.process_up_and_down();
         forward_context->reached->clear();
     }
+
+    VertexPtr add_vertex() override;
 };
 
-// The paper uses an assumption that each vertex has degree O(m / n).
-// The procedure to justify this assumption is used here.
-class SparsifiedSampleSearch : public SampleSearch {
+class SampleSearch : public PartitionedSearch {
    private:
-    SimpleGraphSparsifierForward graph_sparsifier_forward;
-    SimpleGraphSparsifierBackward graph_sparsifier_backward;
+    ForwardExplorer forward_explorer;
+    BackwardExplorer backward_explorer;
+    std::vector<Vertex_id_t> new_scc_canonical_ids;
+    std::vector<Vertex_id_t> new_canonical_order;
+    Vertex_id_t restore_canonical_order_helper;
+
+    void find_component(const VertexPtr &u, const VertexPtr &v);
+
+    void unionize_and_remove_non_canonical(Vertex_id_t start_id);
+    // Execute UpdateForward / UpdateBackward from the 3rd Phase.
+    void update_order(const VertexPtr &u, const VertexPtr &v,
+                      bool update_forward);
+
+   protected:
+    void postprocess_edge(VertexPtr u, VertexPtr v) override;
+    void algorithm_step(VertexPtr u, VertexPtr v) override;
 
    public:
-    SparsifiedSampleSearch(size_t no_vertices, size_t original_no_vertices,
-                           DynamicOrderPtr order)
-        : SampleSearch(no_vertices, std::move(order), original_no_vertices),
-          graph_sparsifier_forward(original_no_vertices),
-          graph_sparsifier_backward(original_no_vertices,
-                                    graph_sparsifier_forward) {}
-
-    void run(const Raw_edges_list &edges) override;
+    SampleSearch(size_t no_vertices, DynamicOrderPtr order,
+                 std::optional<size_t> sample_size =
+                     AlgorithmOptions::DEFAULT_SAMPLE_SIZE,
+                 std::optional<size_t> original_no_vertices = std::nullopt)
+        : PartitionedSearch(no_vertices, std::move(order), sample_size,
+                            original_no_vertices),
+          forward_explorer(this->order, graph,
+                           partitions_handler.get_partitions(), find_union),
+          backward_explorer(this->order, reversed_graph,
+                            partitions_handler.get_partitions(), find_union) {
+        restore_canonical_order_helper = this->order->total_elements_capacity();
+        this->order->extend_elements_capacity();
+    }
+
+    VertexPtr add_vertex() override;
 };
 
 #endif  // SAMPLE_SEARCH_HPP
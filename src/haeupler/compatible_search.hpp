@@ -4,31 +4,46 @@
 /// Implements Compatible Search from https://doi.org/10.1145/2071379.2071382.
 /// Works in total time O(m^{3/2} * log(n)).
 
-#include <set>
+#include <functional>
 
 #include "haeupler_search.hpp"
 #include "utils/dynamic_order.hpp"
+#include "utils/order_heap.hpp"
 
 // Since forward and backward steps are analogous we introduce a common class
-// that catches this common behaviour.
+// that catches this common behaviour. Live vertices are kept in a heap
+// ordered by `KeyCompare` applied to the cached keys of the order.
+template <typename KeyCompare>
 class CompatibleTraversal : public Traversal {
    protected:
-    std::set<Vertex_id_t, DynamicOrderComparator> live;
+    OrderHeap<KeyCompare> live;
 
-    void insert_active_vertex(Vertex_id_t vertex_id) override;
-    void remove_active_vertex(Vertex_id_t vertex_id) override;
+    void insert_active_vertex(Vertex_id_t vertex_id) override {
+        live.insert(vertex_id);
+    }
+    void remove_active_vertex(Vertex_id_t vertex_id) override {
+        live.erase(vertex_id);
+    }
 
    public:
     CompatibleTraversal(size_t no_vertices, const DynamicOrderPtr &order)
-        : Traversal(no_vertices, order), live(order_comparator) {}
+        : Traversal(no_vertices, order), live(no_vertices, order) {}
     ~CompatibleTraversal() override = default;
 
-    virtual std::optional<Vertex_id_t> get_best_live_option() = 0;
+    void add_vertex() override {
+        Traversal::add_vertex();
+        live.add_element();
+    }
 
-    void clear() override;
+    std::optional<Vertex_id_t> get_best_live_option() { return live.top(); }
+
+    void clear() override {
+        Traversal::clear();
+        live.clear();
+    }
 };
 
-class CompatibleForwardTraversal : public CompatibleTraversal {
+class CompatibleForwardTraversal : public CompatibleTraversal<std::less<>> {
    protected:
     bool on_the_good_side_of_pivot(Vertex_id_t candidate_id,
                                    Vertex_id_t pivot_id) override;
@@ -36,11 +51,10 @@ class CompatibleForwardTraversal : public CompatibleTraversal {
    public:
     CompatibleForwardTraversal(size_t no_vertices, const DynamicOrderPtr &order)
         : CompatibleTraversal(no_vertices, order) {}
-
-    std::optional<Vertex_id_t> get_best_live_option() override;
 };
 
-class CompatibleBackwardTraversal : public CompatibleTraversal {
+class CompatibleBackwardTraversal
+    : public CompatibleTraversal<std::greater<>> {
    protected:
     bool on_the_good_side_of_pivot(Vertex_id_t candidate_id,
                                    Vertex_id_t pivot_id) override;
@@ -49,8 +63,6 @@ class CompatibleBackwardTraversal : public CompatibleTraversal {
     CompatibleBackwardTraversal(size_t no_vertices,
                                 const DynamicOrderPtr &order)
         : CompatibleTraversal(no_vertices, order) {}
-
-    std::optional<Vertex_id_t> get_best_live_option() override;
 };
 
 class CompatibleSearch : public HaeuplerSearch {
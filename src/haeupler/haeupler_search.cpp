@@ -2,20 +2,24 @@
 
 #include <algorithm>
 
-void Traversal::insert_vertex(const VertexPtr &u, Graph &graph,
-                              size_t no_traversals) {
-    if (visited[u->id] == no_traversals)
+void Traversal::add_vertex() {
+    visited.add_element();
+    next_neighbour.emplace_back();
+}
+
+void Traversal::insert_vertex(const VertexPtr &u, Graph &graph) {
+    if (visited.is_marked(u->id))
         return;
 
     traversed.push_back(u);
-    visited[u->id] = no_traversals;
+    visited.mark(u->id);
     next_neighbour[u->id] = graph.get_neighbours_begin(u);
     if (next_neighbour[u->id] != graph.get_neighbours_end(u))
         insert_active_vertex(u->id);
 }
 
-Vertex_list::iterator Traversal::get_next_neighbour_iterator(const VertexPtr &u,
-                                                             Graph &graph) {
+NeighbourList::iterator Traversal::get_next_neighbour_iterator(
+    const VertexPtr &u, Graph &graph) {
     const auto neighbour = next_neighbour[u->id];
     next_neighbour[u->id] = std::next(next_neighbour[u->id]);
     if (next_neighbour[u->id] == graph.get_neighbours_end(u))
@@ -45,29 +49,30 @@ std::vector<Vertex_id_t> Traversal::get_sorted_vertices_based_on_pivot(
     return vertex_ids;
 }
 
-void Traversal::clear() { traversed.clear(); }
+void Traversal::clear() {
+    traversed.clear();
+    visited.next_epoch();
+}
 
 void HaeuplerSearch::search_step(const VertexPtr &u, const VertexPtr &v) {
     const auto x_iter =
         forward_traversal->get_next_neighbour_iterator(u, graph);
-    const auto x = find_representative_vertex(*x_iter);
+    const auto x = find_representative_vertex(x_iter.id());
     if (x == u) {
         graph.erase_neighbour(u, x_iter);
     } else {
         scc_detector.add_edge(u, x);
-        within_scc_detector.push_back(u);
-        forward_traversal->insert_vertex(x, graph, no_traversals);
+        forward_traversal->insert_vertex(x, graph);
     }
 
     const auto y_iter =
         backward_traversal->get_next_neighbour_iterator(v, reversed_graph);
-    const auto y = find_representative_vertex(*y_iter);
+    const auto y = find_representative_vertex(y_iter.id());
     if (y == v) {
         reversed_graph.erase_neighbour(v, y_iter);
     } else {
         scc_detector.add_edge(y, v);
-        within_scc_detector.push_back(y);
-        backward_traversal->insert_vertex(y, reversed_graph, no_traversals);
+        backward_traversal->insert_vertex(y, reversed_graph);
     }
 }
 
@@ -103,49 +108,53 @@ void HaeuplerSearch::restore_topological_order(const VertexPtr &default_pivot) {
     }
 }
 
-void HaeuplerSearch::find_new_connected_component(const VertexPtr &current,
-                                                  const VertexPtr &u) {
-    visited[current->id] = no_traversals;
-
-    for (auto neighbour_iter = scc_detector.get_neighbours_begin(current);
-         neighbour_iter != scc_detector.get_neighbours_end(current);
-         ++neighbour_iter) {
-        const auto &neighbour = *neighbour_iter;
-        if (visited[neighbour->id] != no_traversals)
-            find_new_connected_component(neighbour, u);
-        if (is_in_new_scc[neighbour->id] == no_traversals)
-            is_in_new_scc[current->id] = no_traversals;
-    }
-
-    if (current == u)
-        is_in_new_scc[current->id] = no_traversals;
-    if (is_in_new_scc[current->id] == no_traversals)
-        new_scc.emplace_back(current);
-}
-
 void HaeuplerSearch::clear() {
-    for (const auto &vertex : within_scc_detector)
-        scc_detector.clean_vertex(vertex);
-    within_scc_detector.clear();
+    scc_detector.clear();
     new_scc.clear();
     forward_traversal->clear();
     backward_traversal->clear();
 }
 
+std::vector<Vertex_id_t> HaeuplerSearch::get_locality_order() {
+    std::vector<Vertex_id_t> locality_order;
+    for (std::optional<Element_t> id = order->first_element(); id.has_value();
+         id = order->next_element(*id))
+        locality_order.push_back(*id);
+    return locality_order;
+}
+
+void HaeuplerSearch::renumber_vertices(
+    const std::vector<Vertex_id_t> &new_ids) {
+    Algorithm::renumber_vertices(new_ids);
+    const auto old_order = get_locality_order();
+    for (const auto id : old_order)
+        order->remove(id);
+    for (const auto id : old_order)
+        order->insert_back(new_ids[id]);
+}
+
+VertexPtr HaeuplerSearch::add_vertex() {
+    const auto u = Algorithm::add_vertex();
+    order->extend_elements_capacity();
+    order->insert_back(u->id);
+    forward_traversal->add_vertex();
+    backward_traversal->add_vertex();
+    return u;
+}
+
 void HaeuplerSearch::algorithm_step(VertexPtr u, VertexPtr v) {
     u = find_representative_vertex(u);
     v = find_representative_vertex(v);
     if (u == v || order->is_before(u->id, v->id))
         return;
 
-    no_traversals++;
-    forward_traversal->insert_vertex(v, graph, no_traversals);
-    backward_traversal->insert_vertex(u, reversed_graph, no_traversals);
+    forward_traversal->insert_vertex(v, graph);
+    backward_traversal->insert_vertex(u, reversed_graph);
 
     perform_search_steps(u);
 
     restore_topological_order(u);
-    find_new_connected_component(v, u);
+    scc_detector.find_new_connected_component(v, u, new_scc);
     merge_into_component(new_scc, {&graph, &reversed_graph});
 
     const auto component_representant = find_representative_vertex(u);
@@ -162,11 +171,28 @@ void HaeuplerSearch::algorithm_step(VertexPtr u, VertexPtr v) {
     clear();
 }
 
+bool HaeuplerSearch::insert_without_search(const VertexPtr &u,
+                                           const VertexPtr &v) {
+    // A sink can be placed anywhere after its predecessors and a source
+    // anywhere before its successors.
+    const auto u_id = find_representative_id(u->id);
+    const auto v_id = find_representative_id(v->id);
+    if (!order->is_before(u_id, v_id)) {
+        if (is_sink(v_id)) {
+            order->remove(v_id);
+            order->insert_after(v_id, u_id);
+        } else {
+            order->remove(u_id);
+            order->insert_before(u_id, v_id);
+        }
+    }
+    postprocess_edge(u, v);
+    return true;
+}
+
 void HaeuplerSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
     u = find_representative_vertex(u);
     v = find_representative_vertex(v);
-    if (u != v) {
+    if (u != v)
         graph.add_edge(u, v);
-        reversed_graph.add_edge(v, u);
-    }
 }
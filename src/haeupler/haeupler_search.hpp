@@ -8,14 +8,17 @@
 
 #include "utils/algorithm.hpp"
 #include "utils/dynamic_order.hpp"
+#include "utils/epoch_markers.hpp"
+#include "utils/scc_detector.hpp"
 
 // Since forward and backward steps are similar we introduce a common class
 // that catch this common behaviour.
 class Traversal {
    protected:
     std::vector<VertexPtr> traversed;
-    std::vector<size_t> visited;
-    std::vector<Vertex_list::iterator> next_neighbour;
+    // Reset by `clear`.
+    EpochMarkers<1> visited;
+    std::vector<NeighbourList::iterator> next_neighbour;
     DynamicOrderComparator order_comparator;
 
     virtual bool on_the_good_side_of_pivot(Vertex_id_t candidate_id,
@@ -31,10 +34,13 @@ class Traversal {
           order_comparator(order) {}
     virtual ~Traversal() = default;
 
-    void insert_vertex(const VertexPtr &u, Graph &graph, size_t no_traversals);
+    // Extends per-vertex data with a vertex appended to the graph.
+    virtual void add_vertex();
 
-    Vertex_list::iterator get_next_neighbour_iterator(const VertexPtr &u,
-                                                      Graph &graph);
+    void insert_vertex(const VertexPtr &u, Graph &graph);
+
+    NeighbourList::iterator get_next_neighbour_iterator(const VertexPtr &u,
+                                                        Graph &graph);
 
     VertexPtr find_pivot(const VertexPtr &initial_pivot, Graph &graph) const;
     std::vector<Vertex_id_t> get_sorted_vertices_based_on_pivot(
@@ -50,37 +56,39 @@ class HaeuplerSearch : public Algorithm {
     std::shared_ptr<Traversal> forward_traversal;
     std::shared_ptr<Traversal> backward_traversal;
     // Used to determine newly created strongly connected components.
-    Graph scc_detector;
-    std::vector<VertexPtr> within_scc_detector;
-    std::vector<Vertex_id_t> visited;
-    std::vector<Vertex_id_t> is_in_new_scc;
+    SccDetector scc_detector;
     std::vector<VertexPtr> new_scc;
 
     void restore_topological_order(const VertexPtr &default_pivot);
 
-    void find_new_connected_component(const VertexPtr &current,
-                                      const VertexPtr &u);
-
     void search_step(const VertexPtr &u, const VertexPtr &v);
     virtual void perform_search_steps(const VertexPtr &u) = 0;
 
     void algorithm_step(VertexPtr u, VertexPtr v) override;
     void postprocess_edge(VertexPtr u, VertexPtr v) override;
+    bool insert_without_search(const VertexPtr &u, const VertexPtr &v) override;
 
     void clear();
 
+    // Walks the order, which keeps only representatives of the components.
+    std::vector<Vertex_id_t> get_locality_order() override;
+    // Traversals are cleared after every edge, so only the order has to
+    // follow the new ids.
+    bool supports_renumbering() const override { return true; }
+    void renumber_vertices(const std::vector<Vertex_id_t> &new_ids) override;
+
    public:
     HaeuplerSearch(size_t no_vertices, DynamicOrderPtr order,
                    std::shared_ptr<Traversal> forward_traversal,
                    std::shared_ptr<Traversal> backward_traversal)
         : Algorithm(no_vertices),
-          reversed_graph(graph),
+          reversed_graph(graph.reversed()),
           order(std::move(order)),
           forward_traversal(std::move(forward_traversal)),
-          backward_traversal(std::move(backward_traversal)),
-          scc_detector(graph),
-          visited(no_vertices),
-          is_in_new_scc(no_vertices) {}
+          backward_traversal(std::move(backward_traversal)) {}
+
+    // New vertices are placed at the end of the order.
+    VertexPtr add_vertex() override;
 };
 
 #endif  // HAEUPLER_SEARCH_HPP
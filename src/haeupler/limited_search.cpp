@@ -1,39 +1,53 @@
 #include "limited_search.hpp"
 
-void LimitedSearch::dfs(const VertexPtr& current, const VertexPtr& target) {
-    visited[current->id] = no_traversals;
-    auto& neighbours = graph.get_neighbours(current);
-    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();) {
-        const auto repr = find_representative_vertex(*neighbour);
-        // Remove loop / duplicated edge.
-        if (repr == current ||
-            visited_edge[{current->id, repr->id}] == no_traversals) {
-            neighbour = neighbours.erase(neighbour);
-            continue;
-        }
-        visited_edge[{current->id, repr->id}] = no_traversals;
-        ++neighbour;
+void LimitedSearch::dfs(const VertexPtr& source, const VertexPtr& target) {
+    const auto propagate = [this](Vertex_id_t current_id, Vertex_id_t repr_id) {
+        if (markers.is_marked(repr_id, REACHES_TARGET))
+            markers.mark(current_id, REACHES_TARGET);
+    };
 
-        if (visited[repr->id] != no_traversals) {
-            if (order.is_before(repr->id, target->id)) {
-                dfs(repr, target);
-            } else {
-                if (repr == target) {
-                    reaches_target[repr->id] = no_traversals;
-                    reached_target.emplace_back(repr);
-                    postorder.emplace_back(repr);
-                }
-                visited[repr->id] = no_traversals;
+    dfs_stack.run(
+        source,
+        [this](const VertexPtr& current) {
+            markers.mark(current->id, VISITED);
+            auto neighbours = graph.get_neighbours(current);
+            return std::pair(neighbours.begin(), neighbours.end());
+        },
+        [&](const VertexPtr& current,
+            NeighbourList::iterator& neighbour) -> std::optional<VertexPtr> {
+            prefetch_next_neighbour(neighbour, markers);
+            const auto repr_id = find_representative_id(neighbour.id());
+            // Remove loop / duplicated edge.
+            if (repr_id == current->id ||
+                visited_edge[{current->id, repr_id}] == no_traversals) {
+                neighbour = graph.get_neighbours(current).erase(neighbour);
+                return std::nullopt;
             }
-        }
+            visited_edge[{current->id, repr_id}] = no_traversals;
+            ++neighbour;
 
-        if (reaches_target[repr->id] == no_traversals)
-            reaches_target[current->id] = no_traversals;
-    }
+            if (!markers.is_marked(repr_id, VISITED)) {
+                if (order.is_before(repr_id, target->id))
+                    return graph.get_vertex_by_id(repr_id);
+                if (repr_id == target->id) {
+                    markers.mark(repr_id, REACHES_TARGET);
+                    reached_target.emplace_back(target);
+                    postorder.emplace_back(target);
+                }
+                markers.mark(repr_id, VISITED);
+            }
 
-    if (reaches_target[current->id] == no_traversals)
-        reached_target.emplace_back(current);
-    postorder.emplace_back(current);
+            propagate(current->id, repr_id);
+            return std::nullopt;
+        },
+        [&](const VertexPtr& current, const VertexPtr& repr) {
+            propagate(current->id, repr->id);
+        },
+        [this](const VertexPtr& current) {
+            if (markers.is_marked(current->id, REACHES_TARGET))
+                reached_target.emplace_back(current);
+            postorder.emplace_back(current);
+        });
 }
 
 void LimitedSearch::process_new_scc(const VertexPtr& target) {
@@ -55,6 +69,7 @@ void LimitedSearch::algorithm_step(VertexPtr u, VertexPtr v) {
         return;
 
     no_traversals++;
+    markers.next_epoch();
     dfs(v, u);
     process_new_scc(u);
 
@@ -62,7 +77,7 @@ void LimitedSearch::algorithm_step(VertexPtr u, VertexPtr v) {
     for (auto iter = postorder.rbegin(); iter != postorder.rend(); ++iter) {
         const auto& w = *iter;
         // Is in the new scc.
-        if (reaches_target[w->id] == no_traversals)
+        if (markers.is_marked(w->id, REACHES_TARGET))
             continue;
         order.remove(w->id);
         order.insert_after(w->id, previous_id);
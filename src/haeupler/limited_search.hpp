@@ -9,24 +9,30 @@
 
 #include "utils/algorithm.hpp"
 #include "utils/dynamic_order.hpp"
+#include "utils/epoch_markers.hpp"
 #include "utils/hash.hpp"
+#include "utils/iterative_dfs.hpp"
 
 class LimitedSearch : public Algorithm {
    private:
+    enum Marker : size_t { VISITED, REACHES_TARGET, NO_MARKERS };
+
     size_t dummy_id;
     DynamicOrderTreap order;
-    std::vector<size_t> visited;
-    std::vector<size_t> reaches_target;
+    EpochMarkers<NO_MARKERS> markers;
+    // Stamps edges within `visited_edge`.
+    size_t no_traversals = 0;
     std::vector<VertexPtr> reached_target;
     std::vector<VertexPtr> postorder;
     std::unordered_map<std::pair<Vertex_id_t, Vertex_id_t>, size_t, PairHash>
         visited_edge;
     constexpr static size_t MAX_VISITED_EDGES_SIZE = 15000;
+    IterativeDfs<VertexPtr, NeighbourList::iterator> dfs_stack;
 
     void postprocess_edge(VertexPtr u, VertexPtr v) override;
     void algorithm_step(VertexPtr u, VertexPtr v) override;
 
-    void dfs(const VertexPtr& current, const VertexPtr& target);
+    void dfs(const VertexPtr& source, const VertexPtr& target);
 
     void process_new_scc(const VertexPtr& target);
 
@@ -35,8 +41,7 @@ class LimitedSearch : public Algorithm {
         : Algorithm(no_vertices),
           dummy_id(no_vertices),
           order(no_vertices + 1),
-          visited(no_vertices),
-          reaches_target(no_vertices) {
+          markers(no_vertices) {
         order.remove(no_vertices);
     }
 };
@@ -86,6 +86,12 @@ void SoftThresholdTraversal::update_active_passive_and_threshold(
     }
 }
 
+void SoftThresholdTraversal::add_vertex() {
+    Traversal::add_vertex();
+    active.add_vertex();
+    passive.add_vertex();
+}
+
 void SoftThresholdTraversal::clear() {
     Traversal::clear();
     active.clear();
@@ -22,6 +22,9 @@ class IndexedList {
 
     Vertex_id_list &get_ids() { return ids; }
 
+    // Makes room for a vertex appended to the graph.
+    void add_vertex() { id_iterators.emplace_back(); }
+
     // Does nothing if element already exists in the list.
     void insert(Vertex_id_t id);
     // Does nothing if element doesn't exist in the list.
@@ -54,6 +57,8 @@ class SoftThresholdTraversal : public Traversal {
           passive(no_vertices) {}
     ~SoftThresholdTraversal() override = default;
 
+    void add_vertex() override;
+
     bool any_active() const;
     Vertex_id_t get_next_active() const;
 
@@ -6,15 +6,30 @@ size_t TopologicalTraversal::canonical_vertices_no;
 
 void TopologicalTraversal::init_queue(const VertexPtr& u) {
     queue.push_back(u);
+    queue_mask.set(u->id);
     current_index = positions[u->id];
     vertices[current_index] = nullptr;
 }
 
 void TopologicalTraversal::push_vertex_at_current_index_to_queue() {
     queue.push_back(vertices[current_index]);
+    queue_mask.set(vertices[current_index]->id);
     vertices[current_index] = nullptr;
 }
 
+bool TopologicalTraversal::edge_from_queue(Vertex_id_t v_id) const {
+    // Either checks every queued vertex or every neighbour of v, whichever
+    // is cheaper.
+    if (queue.size() < reversed_edges.get_row_cost(v_id)) {
+        for (const auto& u : queue) {
+            if (edges.contains(u->id, v_id))
+                return true;
+        }
+        return false;
+    }
+    return reversed_edges.row_intersects(v_id, queue_mask);
+}
+
 bool TopologicalTraversal::is_before(const VertexPtr& u, const VertexPtr& v) {
     return positions[u->id] < positions[v->id];
 }
@@ -27,14 +42,7 @@ bool TopologicalTraversal::topological_search_step(
     size_t other_traversal_index) {
     update_current_index();
     while (correct_order_of_indices(other_traversal_index)) {
-        bool edge_exists = false;
-        for (const auto& v : queue) {
-            if (edge(v->id, vertices[current_index]->id)) {
-                edge_exists = true;
-                break;
-            }
-        }
-        if (edge_exists)
+        if (edge_from_queue(vertices[current_index]->id))
             break;
         update_current_index();
     }
@@ -48,18 +56,14 @@ bool TopologicalTraversal::topological_search_step(
 
 void TopologicalTraversal::reorder() {
     while (!queue.empty()) {
-        if (vertices[current_index]) {
-            for (const auto& u : queue) {
-                if (edge(u->id, vertices[current_index]->id)) {
-                    push_vertex_at_current_index_to_queue();
-                    break;
-                }
-            }
-        }
+        if (vertices[current_index] &&
+            edge_from_queue(vertices[current_index]->id))
+            push_vertex_at_current_index_to_queue();
 
         if (!vertices[current_index]) {
             const auto u = queue.front();
             queue.pop_front();
+            queue_mask.reset(u->id);
             vertices[current_index] = u;
             positions[u->id] = current_index;
         }
@@ -97,10 +101,6 @@ bool TopologicalForwardTraversal::correct_order_of_indices(
     return current_index < other_traversal_index;
 }
 
-bool TopologicalForwardTraversal::edge(Vertex_id_t u_id, Vertex_id_t v_id) {
-    return incidence_matrix[u_id][v_id];
-}
-
 void TopologicalBackwardTraversal::update_current_index() { --current_index; }
 
 bool TopologicalBackwardTraversal::correct_order_of_indices(
@@ -108,10 +108,6 @@ bool TopologicalBackwardTraversal::correct_order_of_indices(
     return current_index > other_traversal_index;
 }
 
-bool TopologicalBackwardTraversal::edge(Vertex_id_t u_id, Vertex_id_t v_id) {
-    return incidence_matrix[v_id][u_id];
-}
-
 void TopologicalSearch::create_scc_detection_graph() {
     const auto& forward_queue = forward_traversal.get_queue();
     const auto& backward_queue = backward_traversal.get_queue();
@@ -121,11 +117,8 @@ void TopologicalSearch::create_scc_detection_graph() {
         for (const auto* queue_v : queues) {
             for (const auto& u : *queue_u) {
                 for (const auto& v : *queue_v) {
-                    if (incidence_matrix[u->id][v->id]) {
+                    if (incidence_matrix.contains(u->id, v->id))
                         scc_detector.add_edge(u, v);
-                        within_scc_detector.emplace_back(u);
-                        within_scc_detector.emplace_back(v);
-                    }
                 }
             }
         }
@@ -148,38 +141,23 @@ void TopologicalSearch::topological_search(const VertexPtr& u,
     }
 }
 
-void TopologicalSearch::find_new_connected_component(const VertexPtr& current,
-                                                     const VertexPtr& u) {
-    visited[current->id] = no_traversals;
-
-    for (auto neighbour_iter = scc_detector.get_neighbours_begin(current);
-         neighbour_iter != scc_detector.get_neighbours_end(current);
-         ++neighbour_iter) {
-        const auto& neighbour = *neighbour_iter;
-        if (visited[neighbour->id] != no_traversals)
-            find_new_connected_component(neighbour, u);
-        if (is_in_new_scc[neighbour->id] == no_traversals)
-            is_in_new_scc[current->id] = no_traversals;
-    }
-
-    if (current == u)
-        is_in_new_scc[current->id] = no_traversals;
-    if (is_in_new_scc[current->id] == no_traversals)
-        new_scc.emplace_back(current);
-}
-
 void TopologicalSearch::adjust_incidence_matrix_with_new_scc() {
     for (size_t i = 1; i < new_scc.size(); i++) {
         const auto union_result =
             find_union.union_elements(new_scc[i - 1]->id, new_scc[i]->id);
         const auto [new_repr_id, old_repr_id] = *union_result;
 
-        for (size_t u_id = 0; u_id < graph.get_no_vertices(); u_id++) {
-            if (incidence_matrix[old_repr_id][u_id])
-                incidence_matrix[new_repr_id][u_id] = true;
-            if (incidence_matrix[u_id][old_repr_id])
-                incidence_matrix[u_id][new_repr_id] = true;
-        }
+        // Columns of one matrix are rows of the other one.
+        incidence_matrix.merge_rows(new_repr_id, old_repr_id);
+        transposed_incidence_matrix.merge_rows(new_repr_id, old_repr_id);
+        incidence_matrix.for_each_in_row(old_repr_id, [&](size_t u_id) {
+            transposed_incidence_matrix.insert(u_id, new_repr_id);
+        });
+        transposed_incidence_matrix.for_each_in_row(
+            old_repr_id,
+            [&](size_t u_id) { incidence_matrix.insert(u_id, new_repr_id); });
+        incidence_matrix.clear_row(old_repr_id);
+        transposed_incidence_matrix.clear_row(old_repr_id);
     }
 }
 
@@ -194,8 +172,7 @@ void TopologicalSearch::algorithm_step(VertexPtr u, VertexPtr v) {
 
     topological_search(u, v);
     create_scc_detection_graph();
-    no_traversals++;
-    find_new_connected_component(v, u);
+    scc_detector.find_new_connected_component(v, u, new_scc);
 
     forward_traversal.reorder();
     backward_traversal.update_current_index();
@@ -212,11 +189,11 @@ void TopologicalSearch::algorithm_step(VertexPtr u, VertexPtr v) {
 void TopologicalSearch::postprocess_edge(VertexPtr u, VertexPtr v) {
     u = find_representative_vertex(u);
     v = find_representative_vertex(v);
-    if (u != v)
-        incidence_matrix[u->id][v->id] = true;
+    if (u != v) {
+        incidence_matrix.insert(u->id, v->id);
+        transposed_incidence_matrix.insert(v->id, u->id);
+    }
 
-    for (const auto& w : within_scc_detector)
-        scc_detector.clean_vertex(w);
-    within_scc_detector.clear();
+    scc_detector.clear();
     new_scc.clear();
 }
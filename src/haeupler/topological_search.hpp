@@ -2,26 +2,34 @@
 #define TOPOLOGICAL_SEARCH_HPP
 
 /// Implements Topological Search from https://doi.org/10.1145/2071379.2071382.
-/// Works in total time O(n^{5/2}). Uses O(n^2) memory regardless from the
-/// total number of edges.
+/// Works in total time O(n^{5/2}). Uses O(n + m) memory, adjacency rows of
+/// high degree are stored as bitsets to keep edge-existence checks fast.
 
 #include <queue>
 
 #include "utils/algorithm.hpp"
+#include "utils/bitset.hpp"
+#include "utils/hybrid_adjacency.hpp"
+#include "utils/scc_detector.hpp"
 
 // Since forward and backward steps are similar we introduce a common class
 // that catch this common behaviour.
 class TopologicalTraversal {
    public:
-    using Incidence_matrix_t = std::vector<std::vector<bool>>;
+    using Incidence_matrix_t = HybridAdjacency;
 
    protected:
     using Vertex_queue_t = std::deque<VertexPtr>;
 
-    const Incidence_matrix_t& incidence_matrix;
+    // Row u of `edges` contains the vertices reachable by a single edge from u
+    // in the direction of the traversal, `reversed_edges` is its transpose.
+    const Incidence_matrix_t& edges;
+    const Incidence_matrix_t& reversed_edges;
     // Variables called `i` and `j` in the paper.
     size_t current_index;
     Vertex_queue_t queue;
+    // Marks vertices which are currently in `queue`.
+    Bitset queue_mask;
     // Arrays called `position` and `vertex` in the paper.
     static std::vector<size_t> positions;
     static std::vector<VertexPtr> vertices;
@@ -30,14 +38,16 @@ class TopologicalTraversal {
     virtual bool correct_order_of_indices(size_t other_traversal_index) = 0;
     void push_vertex_at_current_index_to_queue();
 
-    // Returns if edge (u, v) exists (forward or backward edge, based on the
-    // traversal type).
-    virtual bool edge(Vertex_id_t u_id, Vertex_id_t v_id) = 0;
+    // Returns if there is an edge from any vertex of the queue to v.
+    bool edge_from_queue(Vertex_id_t v_id) const;
 
    public:
-    TopologicalTraversal(Graph& graph,
-                         const Incidence_matrix_t& incidence_matrix)
-        : incidence_matrix(incidence_matrix), current_index(0) {
+    TopologicalTraversal(Graph& graph, const Incidence_matrix_t& edges,
+                         const Incidence_matrix_t& reversed_edges)
+        : edges(edges),
+          reversed_edges(reversed_edges),
+          current_index(0),
+          queue_mask(graph.get_no_vertices()) {
         const auto no_vertices = graph.get_no_vertices();
         canonical_vertices_no = no_vertices;
         positions.resize(no_vertices);
@@ -73,12 +83,12 @@ class TopologicalForwardTraversal : public TopologicalTraversal {
    protected:
     bool correct_order_of_indices(size_t other_traversal_index) override;
 
-    bool edge(Vertex_id_t u_id, Vertex_id_t v_id) override;
-
    public:
-    TopologicalForwardTraversal(Graph& graph,
-                                const Incidence_matrix_t& incidence_matrix)
-        : TopologicalTraversal(graph, incidence_matrix) {}
+    TopologicalForwardTraversal(
+        Graph& graph, const Incidence_matrix_t& incidence_matrix,
+        const Incidence_matrix_t& transposed_incidence_matrix)
+        : TopologicalTraversal(graph, incidence_matrix,
+                               transposed_incidence_matrix) {}
 
     void update_current_index() override;
 };
@@ -87,12 +97,12 @@ class TopologicalBackwardTraversal : public TopologicalTraversal {
    protected:
     bool correct_order_of_indices(size_t other_traversal_index) override;
 
-    bool edge(Vertex_id_t u_id, Vertex_id_t v_id) override;
-
    public:
-    TopologicalBackwardTraversal(Graph& graph,
-                                 const Incidence_matrix_t& incidence_matrix)
-        : TopologicalTraversal(graph, incidence_matrix) {}
+    TopologicalBackwardTraversal(
+        Graph& graph, const Incidence_matrix_t& incidence_matrix,
+        const Incidence_matrix_t& transposed_incidence_matrix)
+        : TopologicalTraversal(graph, transposed_incidence_matrix,
+                               incidence_matrix) {}
 
     void update_current_index() override;
 };
@@ -101,20 +111,18 @@ class TopologicalSearch : public Algorithm {
    private:
     using Vertex_queue_t = std::deque<VertexPtr>;
     TopologicalTraversal::Incidence_matrix_t incidence_matrix;
+    // Kept in sync with `incidence_matrix`, allows to update its columns by
+    // processing rows.
+    TopologicalTraversal::Incidence_matrix_t transposed_incidence_matrix;
     TopologicalForwardTraversal forward_traversal;
     TopologicalBackwardTraversal backward_traversal;
     // Used to determine newly created strongly connected components.
-    Graph scc_detector;
-    std::vector<VertexPtr> within_scc_detector;
-    std::vector<Vertex_id_t> visited;
+    SccDetector scc_detector;
     std::vector<VertexPtr> new_scc;
-    std::vector<size_t> is_in_new_scc;
 
     void topological_search(const VertexPtr& u, const VertexPtr& v);
 
     void create_scc_detection_graph();
-    void find_new_connected_component(const VertexPtr& current,
-                                      const VertexPtr& u);
     void adjust_incidence_matrix_with_new_scc();
 
     void algorithm_step(VertexPtr u, VertexPtr v) override;
@@ -123,12 +131,12 @@ class TopologicalSearch : public Algorithm {
    public:
     explicit TopologicalSearch(size_t no_vertices)
         : Algorithm(no_vertices),
-          incidence_matrix(no_vertices, std::vector<bool>(no_vertices)),
-          forward_traversal(graph, incidence_matrix),
-          backward_traversal(graph, incidence_matrix),
-          scc_detector(graph),
-          visited(no_vertices),
-          is_in_new_scc(no_vertices) {}
+          incidence_matrix(no_vertices),
+          transposed_incidence_matrix(no_vertices),
+          forward_traversal(graph, incidence_matrix,
+                            transposed_incidence_matrix),
+          backward_traversal(graph, incidence_matrix,
+                             transposed_incidence_matrix) {}
 };
 
 #endif  // TOPOLOGICAL_SEARCH_HPP
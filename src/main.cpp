@@ -1,7 +1,13 @@
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <iostream>
 
 #include "utils/algorithm_factory.hpp"
+#include "utils/edge_filter.hpp"
+#include "utils/huge_pages.hpp"
+#include "utils/out_of_core.hpp"
+#include "utils/relabeling.hpp"
 #include "utils/rng.hpp"
 
 Raw_edges_list read_edges_from_file(const std::string &filename) {
@@ -28,9 +34,109 @@ size_t get_maximum_vertex_id(const Raw_edges_list &edges) {
     return max_id;
 }
 
+size_t parse_positive_number(const std::string &value,
+                             const std::string &flag) {
+    if (value.empty() ||
+        !std::all_of(value.begin(), value.end(),
+                     [](unsigned char c) { return std::isdigit(c); }) ||
+        std::stoull(value) == 0)
+        throw std::invalid_argument("Expected a positive number in " + flag);
+    return std::stoull(value);
+}
+
+// Flags handled by main on top of the ones passed to the algorithm.
+struct Options {
+    AlgorithmOptions algorithm;
+    Relabeling relabeling = Relabeling::NONE;
+    bool huge_pages = false;
+    // Removes self-loops and repeated edges from the input.
+    bool deduplicate = false;
+    // Directory for files backing adjacency lists.
+    std::optional<std::string> out_of_core_directory;
+    // Prints statistics of the run to stderr.
+    bool stats = false;
+};
+
+// Parses flags given after the algorithm name and the test case.
+Options parse_options(int argc, char *argv[]) {
+    static const std::string SAMPLE_SIZE_FLAG = "--sample-size=";
+    static const std::string COMPRESSED_FLAG = "--compressed";
+    static const std::string RELABEL_FLAG = "--relabel=";
+    static const std::string REORDER_EVERY_FLAG = "--reorder-every=";
+    static const std::string RENUMBER_FLAG = "--renumber";
+    static const std::string HUGE_PAGES_FLAG = "--huge-pages";
+    static const std::string OUT_OF_CORE_FLAG = "--out-of-core=";
+    static const std::string PREFILTER_FLAG = "--prefilter";
+    static const std::string STATS_FLAG = "--stats";
+    static const std::string DEDUPLICATE_FLAG = "--dedup";
+    static const std::string DROP_SAME_SCC_FLAG = "--drop-same-scc";
+
+    Options options;
+    for (int i = 3; i < argc; i++) {
+        const std::string flag = argv[i];
+        if (flag.starts_with(SAMPLE_SIZE_FLAG)) {
+            const auto value = flag.substr(SAMPLE_SIZE_FLAG.size());
+            if (value == "auto")
+                options.algorithm.sample_size = std::nullopt;
+            else
+                options.algorithm.sample_size =
+                    parse_positive_number(value, flag);
+            options.algorithm.bernstein_chechik_sample_size =
+                options.algorithm.sample_size;
+        } else if (flag == COMPRESSED_FLAG) {
+            options.algorithm.compressed_adjacency = true;
+        } else if (flag.starts_with(REORDER_EVERY_FLAG)) {
+            options.algorithm.reorder_every = parse_positive_number(
+                flag.substr(REORDER_EVERY_FLAG.size()), flag);
+        } else if (flag == RENUMBER_FLAG) {
+            options.algorithm.renumber = true;
+        } else if (flag == HUGE_PAGES_FLAG) {
+            options.huge_pages = true;
+        } else if (flag.starts_with(OUT_OF_CORE_FLAG)) {
+            const auto directory = flag.substr(OUT_OF_CORE_FLAG.size());
+            if (directory.empty())
+                throw std::invalid_argument("Expected a directory in " + flag);
+            options.out_of_core_directory = directory;
+        } else if (flag == PREFILTER_FLAG) {
+            options.algorithm.prefilter = true;
+        } else if (flag == STATS_FLAG) {
+            options.stats = true;
+        } else if (flag == DEDUPLICATE_FLAG) {
+            options.deduplicate = true;
+        } else if (flag == DROP_SAME_SCC_FLAG) {
+            options.algorithm.drop_same_component = true;
+        } else if (flag.starts_with(RELABEL_FLAG)) {
+            const auto relabeling =
+                parse_relabeling(flag.substr(RELABEL_FLAG.size()));
+            if (!relabeling.has_value())
+                throw std::invalid_argument("Unknown relabeling in " + flag);
+            options.relabeling = *relabeling;
+        } else {
+            throw std::invalid_argument("Unknown flag: " + flag);
+        }
+    }
+    // Compressed blocks are kept in memory, which would defeat the purpose.
+    if (options.out_of_core_directory.has_value() &&
+        options.algorithm.compressed_adjacency)
+        throw std::invalid_argument(
+            "--out-of-core can't be combined with --compressed");
+    if (options.algorithm.renumber && options.algorithm.reorder_every == 0)
+        throw std::invalid_argument("--renumber requires --reorder-every");
+    // Compressed blocks store ids which would have to be re-encoded.
+    if (options.algorithm.renumber && options.algorithm.compressed_adjacency)
+        throw std::invalid_argument(
+            "--renumber can't be combined with --compressed");
+    return options;
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <algorithm> <test_case>\n";
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <algorithm> <test_case> [--sample-size=<k|auto>]"
+                     " [--compressed] [--relabel=<none|bfs|degree>]"
+                     " [--reorder-every=<k>] [--renumber] [--huge-pages]"
+                     " [--out-of-core=<directory>] [--prefilter] [--dedup]"
+                     " [--drop-same-scc] [--stats]\n";
         return 1;
     }
 
@@ -42,11 +148,36 @@ int main(int argc, char *argv[]) {
     const std::string test_file = argv[2];
 
     try {
-        const auto &edges = read_edges_from_file(test_file);
+        const auto options = parse_options(argc, argv);
+        if (options.huge_pages)
+            enable_huge_pages();
+        if (options.out_of_core_directory.has_value())
+            enable_out_of_core(*options.out_of_core_directory);
+        auto edges = read_edges_from_file(test_file);
         const auto no_vertices = get_maximum_vertex_id(edges) + 1;
-        const auto algorithm = create_algorithm(algorithm_name, no_vertices);
+        const auto no_input_edges = edges.size();
+        DeduplicationStats deduplication_stats;
+        if (options.deduplicate)
+            deduplication_stats = deduplicate_edges(edges, no_vertices);
+        std::vector<Vertex_id_t> new_ids;
+        if (options.relabeling != Relabeling::NONE) {
+            new_ids = compute_relabeling(edges, no_vertices,
+                                         options.relabeling);
+            relabel_edges(edges, new_ids);
+        }
+        const auto algorithm = create_algorithm(
+            algorithm_name, no_vertices, edges.size(), options.algorithm);
         algorithm->run(edges);
-        algorithm->print_sccs(no_vertices);
+        algorithm->print_sccs(no_vertices, new_ids);
+        if (options.stats) {
+            if (options.deduplicate)
+                std::cerr << "Input edges: " << no_input_edges
+                          << ", self-loops removed: "
+                          << deduplication_stats.no_self_loops
+                          << ", duplicates removed: "
+                          << deduplication_stats.no_duplicates << "\n";
+            algorithm->print_stats(std::cerr);
+        }
     } catch (const std::exception &e) {
         std::cerr << e.what() << "\n";
         return 1;
@@ -6,17 +6,20 @@ std::vector<VertexPtr> NaiveDfs::dfs(const VertexPtr& source, Graph& g,
     std::vector<VertexPtr> encountered;
 
     to_be_considered.push_back(source);
-    visited[source->id] = no_traversals;
+    visited.mark(source->id);
     while (!to_be_considered.empty()) {
         const auto current = to_be_considered.back();
         if (store_encountered)
             encountered.push_back(current);
         to_be_considered.pop_back();
 
-        for (const auto& neighbour : g.get_neighbours(current)) {
-            if (visited[neighbour->id] != no_traversals) {
-                visited[neighbour->id] = no_traversals;
-                to_be_considered.push_back(neighbour);
+        auto neighbours = g.get_neighbours(current);
+        for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();
+             ++neighbour) {
+            prefetch_next_neighbour(neighbour, visited);
+            if (!visited.is_marked(neighbour.id())) {
+                visited.mark(neighbour.id());
+                to_be_considered.push_back(*neighbour);
             }
         }
     }
@@ -29,20 +32,19 @@ void NaiveDfs::algorithm_step(VertexPtr u, VertexPtr v) {
     if (find_representative_vertex(u) == find_representative_vertex(v))
         return;
 
-    no_traversals++;
+    visited.next_epoch();
     const auto& encountered = dfs(u, graph, true);
-    no_traversals++;
+    visited.next_epoch();
     dfs(u, reversed_graph, false);
 
     // Vertices belonging to SCC of u are exactly those who are reachable
     // from u and can reach u.
     for (const auto& w : encountered) {
-        if (visited[w->id] == no_traversals)
+        if (visited.is_marked(w->id))
             find_union.union_elements(u->id, w->id);
     }
 }
 
 void NaiveDfs::preprocess_edge(VertexPtr u, VertexPtr v) {
     graph.add_edge(u, v);
-    reversed_graph.add_edge(v, u);
 }
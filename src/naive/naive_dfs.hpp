@@ -6,11 +6,12 @@
 /// O(m * (n + m)).
 
 #include "utils/algorithm.hpp"
+#include "utils/epoch_markers.hpp"
 
 class NaiveDfs : public Algorithm {
    private:
     Graph reversed_graph;
-    std::vector<size_t> visited;
+    EpochMarkers<1> visited;
 
     void preprocess_edge(VertexPtr u, VertexPtr v) override;
     void algorithm_step(VertexPtr u, VertexPtr v) override;
@@ -19,7 +20,9 @@ class NaiveDfs : public Algorithm {
 
    public:
     explicit NaiveDfs(size_t no_vertices)
-        : Algorithm(no_vertices), reversed_graph(graph), visited(no_vertices) {}
+        : Algorithm(no_vertices),
+          reversed_graph(graph.reversed()),
+          visited(no_vertices) {}
 };
 
 #endif  // NAIVE_DFS_HPP
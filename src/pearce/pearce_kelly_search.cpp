@@ -0,0 +1,161 @@
+#include "pearce_kelly_search.hpp"
+
+#include <algorithm>
+
+PearceKellySearch::PearceKellySearch(size_t no_vertices)
+    : Algorithm(no_vertices),
+      reversed_graph(graph.reversed()),
+      markers(no_vertices) {
+    for (Vertex_id_t vertex_id = 0; vertex_id < no_vertices; vertex_id++)
+        index(vertex_id) = vertex_id;
+}
+
+VertexPtr PearceKellySearch::add_vertex() {
+    const auto u = Algorithm::add_vertex();
+    markers.add_element(markers.size());
+    return u;
+}
+
+bool PearceKellySearch::search_forward(const VertexPtr& u, const VertexPtr& v) {
+    bool found_cycle = false;
+    markers.mark(v->id, VISITED_FORWARD);
+    stack.push_back(v);
+
+    while (!stack.empty()) {
+        const auto current = stack.back();
+        stack.pop_back();
+        reached_forward.push_back(current);
+        // All successors of u have greater indices.
+        if (current == u) {
+            found_cycle = true;
+            continue;
+        }
+
+        auto neighbours = graph.get_neighbours(current);
+        for (auto neighbour = neighbours.begin();
+             neighbour != neighbours.end();) {
+            prefetch_next_neighbour(neighbour, markers);
+            const auto repr_id = find_representative_id(neighbour.id());
+            // Remove loop.
+            if (repr_id == current->id) {
+                neighbour = neighbours.erase(neighbour, true);
+                continue;
+            }
+            ++neighbour;
+
+            if (index(repr_id) <= index(u->id) &&
+                !markers.is_marked(repr_id, VISITED_FORWARD)) {
+                markers.mark(repr_id, VISITED_FORWARD);
+                stack.push_back(graph.get_vertex_by_id(repr_id));
+            }
+        }
+    }
+
+    return found_cycle;
+}
+
+void PearceKellySearch::search_backward(const VertexPtr& u,
+                                        const VertexPtr& v) {
+    markers.mark(u->id, VISITED_BACKWARD);
+    stack.push_back(u);
+
+    while (!stack.empty()) {
+        const auto current = stack.back();
+        stack.pop_back();
+        reached_backward.push_back(current);
+        // All predecessors of v have smaller indices.
+        if (current == v)
+            continue;
+
+        auto neighbours = reversed_graph.get_neighbours(current);
+        for (auto neighbour = neighbours.begin();
+             neighbour != neighbours.end();) {
+            prefetch_next_neighbour(neighbour, markers);
+            const auto repr_id = find_representative_id(neighbour.id());
+            // Remove loop.
+            if (repr_id == current->id) {
+                neighbour = neighbours.erase(neighbour, true);
+                continue;
+            }
+            ++neighbour;
+
+            if (index(repr_id) >= index(v->id) &&
+                !markers.is_marked(repr_id, VISITED_BACKWARD)) {
+                markers.mark(repr_id, VISITED_BACKWARD);
+                stack.push_back(graph.get_vertex_by_id(repr_id));
+            }
+        }
+    }
+}
+
+void PearceKellySearch::reorder() {
+    // Indices of all affected vertices are reused. Vertices merged into the
+    // new component leave gaps, which don't break the invariant.
+    freed_indices.clear();
+    for (const auto& vertex : reached_backward)
+        freed_indices.push_back(index(vertex->id));
+    for (const auto& vertex : reached_forward) {
+        if (!markers.is_marked(vertex->id, VISITED_BACKWARD))
+            freed_indices.push_back(index(vertex->id));
+    }
+    std::sort(freed_indices.begin(), freed_indices.end());
+
+    const auto by_index = [this](const VertexPtr& x, const VertexPtr& y) {
+        return index(x->id) < index(y->id);
+    };
+    const auto within_component = [this](const VertexPtr& x) {
+        return markers.is_marked(x->id, VISITED_FORWARD) &&
+               markers.is_marked(x->id, VISITED_BACKWARD);
+    };
+    std::erase_if(reached_backward, within_component);
+    std::erase_if(reached_forward, within_component);
+    std::sort(reached_backward.begin(), reached_backward.end(), by_index);
+    std::sort(reached_forward.begin(), reached_forward.end(), by_index);
+
+    auto next_index = freed_indices.begin();
+    for (const auto& vertex : reached_backward)
+        index(vertex->id) = *next_index++;
+    // Remaining indices are assigned from the back, so the gaps left by the
+    // merged vertices end up inside the new component.
+    auto last_index = freed_indices.end();
+    for (auto vertex = reached_forward.rbegin();
+         vertex != reached_forward.rend(); ++vertex)
+        index((*vertex)->id) = *--last_index;
+    if (!component.empty())
+        index(find_representative_vertex(component.front())->id) =
+            *--last_index;
+}
+
+void PearceKellySearch::algorithm_step(VertexPtr u, VertexPtr v) {
+    u = find_representative_vertex(u);
+    v = find_representative_vertex(v);
+    if (u == v || index(u->id) < index(v->id))
+        return;
+
+    markers.next_epoch();
+    const auto found_cycle = search_forward(u, v);
+    search_backward(u, v);
+
+    if (found_cycle) {
+        // The new component consists of vertices reachable from v which
+        // reach u.
+        for (const auto& vertex : reached_forward) {
+            if (markers.is_marked(vertex->id, VISITED_BACKWARD))
+                component.push_back(vertex);
+        }
+        merge_into_component(component, {&graph, &reversed_graph});
+    }
+
+    reorder();
+}
+
+void PearceKellySearch::postprocess_edge(VertexPtr u, VertexPtr v) {
+    u = find_representative_vertex(u);
+    v = find_representative_vertex(v);
+    if (u != v)
+        graph.add_edge(u, v);
+
+    reached_forward.clear();
+    reached_backward.clear();
+    component.clear();
+}
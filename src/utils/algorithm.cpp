@@ -2,10 +2,15 @@
 
 #include <iostream>
 #include <iterator>
+#include <stdexcept>
+#include <string>
 
 VertexPtr Algorithm::find_representative_vertex(const VertexPtr &u) {
-    const auto repr_id = find_union.find_representant(u->id);
-    return graph.get_vertex_by_id(repr_id);
+    return find_representative_vertex(u->id);
+}
+
+VertexPtr Algorithm::find_representative_vertex(Vertex_id_t id) {
+    return graph.get_vertex_by_id(find_union.find_representant(id));
 }
 
 void Algorithm::merge_into_component(const std::vector<VertexPtr> &vertices,
@@ -20,49 +25,158 @@ void Algorithm::merge_into_component(const std::vector<VertexPtr> &vertices,
         for (auto &g : graphs)
             g->move_neighbours_by_id(old_repr_id, new_repr_id);
     }
+
+    if (vertices.empty())
+        return;
+    const auto component_representant =
+        find_representative_vertex(vertices.front());
+    for (auto &g : graphs)
+        compact_neighbours_if_needed(*g, component_representant);
+}
+
+void Algorithm::compact_neighbours_if_needed(Graph &g, const VertexPtr &u) {
+    if (!g.should_compact(u))
+        return;
+
+    compaction_markers.next_epoch();
+    compaction_markers.mark(u->id);
+    auto neighbours = g.get_neighbours(u);
+    for (auto neighbour = neighbours.begin(); neighbour != neighbours.end();) {
+        const auto repr = find_representative_vertex(neighbour.id());
+        if (compaction_markers.is_marked(repr->id)) {
+            // Only loops are useless in the reversed graph as well.
+            neighbour = neighbours.erase(neighbour, repr == u);
+            continue;
+        }
+        compaction_markers.mark(repr->id);
+        neighbours.redirect(neighbour, repr);
+        ++neighbour;
+    }
+    g.mark_compacted(u);
 }
 
 void Algorithm::preprocess_edge(VertexPtr, VertexPtr) {}
 
 void Algorithm::postprocess_edge(VertexPtr, VertexPtr) {}
 
-void Algorithm::run(const Raw_edges_list &edges) {
-    for (const auto &edge : edges) {
-        const auto [u_id, v_id] = edge;
-        const auto u = graph.get_vertex_by_id(u_id);
-        const auto v = graph.get_vertex_by_id(v_id);
+void Algorithm::compress_adjacency() { graph.compress(); }
+
+void Algorithm::reorder_adjacency() {
+    const auto order = get_locality_order();
+    graph.reorder(order);
+    if (!renumbering)
+        return;
+
+    // Vertices outside of the order keep their relative order after it.
+    const auto no_vertices = graph.get_no_vertices();
+    std::vector<Vertex_id_t> new_ids(no_vertices, no_vertices);
+    Vertex_id_t next_id = 0;
+    for (const auto u : order)
+        new_ids[u] = next_id++;
+    for (Vertex_id_t u = 0; u < no_vertices; u++) {
+        if (new_ids[u] == no_vertices)
+            new_ids[u] = next_id++;
+    }
+    renumber_vertices(new_ids);
+}
+
+void Algorithm::renumber_vertices(const std::vector<Vertex_id_t> &new_ids) {
+    graph.renumber(new_ids);
+    find_union.renumber(new_ids);
+    if (prefilter)
+        incidence_markers.permute(new_ids);
+
+    if (internal_ids.empty()) {
+        internal_ids = new_ids;
+        return;
+    }
+    for (auto &id : internal_ids)
+        id = new_ids[id];
+}
+
+void Algorithm::enable_renumbering() {
+    if (!supports_renumbering())
+        throw std::invalid_argument(
+            "The algorithm doesn't support renumbering");
+    renumbering = true;
+}
+
+void Algorithm::enable_prefilter() {
+    prefilter = true;
+    incidence_markers.resize(graph.get_no_vertices());
+}
+
+VertexPtr Algorithm::add_vertex() {
+    find_union.add_element();
+    compaction_markers.add_element();
+    if (prefilter)
+        incidence_markers.add_element();
+    return graph.add_vertex();
+}
+
+void Algorithm::process_edge(const VertexPtr &u, const VertexPtr &v) {
+    if (drop_same_component &&
+        find_representative_id(u->id) == find_representative_id(v->id)) {
+        no_dropped_edges++;
+    } else if (prefilter && u != v && (is_sink(v->id) || is_source(u->id)) &&
+               insert_without_search(u, v)) {
+        no_filtered_edges++;
+    } else {
         preprocess_edge(u, v);
         algorithm_step(u, v);
         postprocess_edge(u, v);
     }
+    if (prefilter) {
+        incidence_markers.mark(u->id, HAS_OUT_EDGE);
+        incidence_markers.mark(v->id, HAS_IN_EDGE);
+    }
+    no_processed_edges++;
+    if (reorder_every != 0 && no_processed_edges % reorder_every == 0)
+        reorder_adjacency();
 }
 
-void Algorithm::print_sccs(size_t original_no_vertices) {
-    const size_t no_vertices = graph.get_no_vertices();
-    std::vector<std::vector<Vertex_id_t>> sccs(no_vertices + 1);
-    for (size_t i = 0; i < original_no_vertices; i++) {
-        const auto v = graph.get_vertex_by_id(i);
-        const auto representant = find_representative_vertex(v);
-        sccs[representant->id].push_back(v->id);
+void Algorithm::run(const Raw_edges_list &edges) {
+    for (const auto &edge : edges) {
+        const auto [u_id, v_id] = edge;
+        process_edge(graph.get_vertex_by_id(internal_id(u_id)),
+                     graph.get_vertex_by_id(internal_id(v_id)));
     }
+}
 
-    for (size_t i = 0; i < no_vertices; i++) {
-        if (sccs[i].empty())
-            continue;
+void Algorithm::print_stats(std::ostream &out) const {
+    const auto print_count = [&](const std::string &label, size_t count) {
+        const auto percentage =
+            no_processed_edges == 0
+                ? 0.0
+                : 100.0 * static_cast<double>(count) /
+                      static_cast<double>(no_processed_edges);
+        out << label << ": " << count << " / " << no_processed_edges << " ("
+            << percentage << "%)\n";
+    };
+    if (prefilter)
+        print_count("Edges inserted without a search", no_filtered_edges);
+    if (drop_same_component)
+        print_count("Edges within one component dropped", no_dropped_edges);
+}
 
-        size_t min_id = i;
-        for (const auto &id : sccs[i])
-            min_id = std::min(min_id, id);
-        if (i != min_id) {
-            sccs[min_id] = std::move(sccs[i]);
-            sccs[i].clear();
-        }
+void Algorithm::print_sccs(size_t original_no_vertices,
+                           const std::vector<Vertex_id_t> &new_ids) {
+    const size_t no_vertices = graph.get_no_vertices();
+    std::vector<std::vector<Vertex_id_t>> sccs(no_vertices);
+    // Vertices are visited in increasing order of their input ids, so
+    // components are discovered in order of their smallest vertex.
+    std::vector<Vertex_id_t> representants;
+    for (size_t i = 0; i < original_no_vertices; i++) {
+        const auto id = internal_id(new_ids.empty() ? i : new_ids[i]);
+        const auto representant = find_representative_vertex(id)->id;
+        if (sccs[representant].empty())
+            representants.push_back(representant);
+        sccs[representant].push_back(i);
     }
 
-    for (size_t i = 0; i < original_no_vertices; i++) {
-        if (sccs[i].empty())
-            continue;
-        std::ranges::copy(sccs[i], std::ostream_iterator<int>(std::cout, " "));
+    for (const auto &representant : representants) {
+        std::ranges::copy(sccs[representant],
+                          std::ostream_iterator<int>(std::cout, " "));
         std::cout << '\n';
     }
 }
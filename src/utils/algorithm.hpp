@@ -1,36 +1,165 @@
 #ifndef ALGORITHM_HPP
 #define ALGORITHM_HPP
 
+#include <algorithm>
+#include <ostream>
+#include <utility>
 #include <vector>
 
+#include "epoch_markers.hpp"
 #include "find_union.hpp"
 
 class Algorithm {
    protected:
-    size_t no_traversals = 0;
     Graph graph;
     FindUnion find_union;
+    // Used to find duplicated neighbours during compaction.
+    EpochMarkers<1> compaction_markers;
+    // Number of processed edges after which `reorder_adjacency` is called,
+    // 0 if never.
+    size_t reorder_every = 0;
+    size_t no_processed_edges = 0;
+    // Set by `enable_prefilter`.
+    bool prefilter = false;
+    // Whether a vertex is the source or the target of any processed edge.
+    // Kept only with the prefilter.
+    enum IncidenceMarker : size_t { HAS_OUT_EDGE, HAS_IN_EDGE, NO_INCIDENCE };
+    EpochMarkers<NO_INCIDENCE> incidence_markers;
+    size_t no_filtered_edges = 0;
+    // Set by `drop_same_component_edges`.
+    bool drop_same_component = false;
+    size_t no_dropped_edges = 0;
+    // Set by `enable_renumbering`.
+    bool renumbering = false;
+    // Ids used by the algorithm for the input ids, which change once vertices
+    // get renumbered. Empty until then.
+    std::vector<Vertex_id_t> internal_ids;
+
+    Vertex_id_t internal_id(Vertex_id_t id) const {
+        return internal_ids.empty() ? id : internal_ids[id];
+    }
 
     VertexPtr find_representative_vertex(const VertexPtr &u);
+    VertexPtr find_representative_vertex(Vertex_id_t id);
+    // Doesn't touch the vertex objects, which are scattered in memory.
+    Vertex_id_t find_representative_id(Vertex_id_t id) const {
+        return find_union.find_representant(id);
+    }
     // Uses union operation to merge multiple components into one.
     // Properly updates incident edges within provided graphs.
     void merge_into_component(const std::vector<VertexPtr> &vertices,
                               const std::vector<Graph *> &graphs);
+    // Once enough neighbours of u were moved to it by merges, rewrites its
+    // list to distinct representatives other than u.
+    void compact_neighbours_if_needed(Graph &g, const VertexPtr &u);
+
+    // Starts loading what resolving the neighbour following `neighbour`
+    // reads, so that cache misses overlap with processing the current one.
+    template <typename Markers>
+    void prefetch_next_neighbour(const NeighbourList::iterator &neighbour,
+                                 const Markers &markers) const {
+        const auto next_id = neighbour.peek_next_id();
+        if (next_id >= markers.size())
+            return;
+        find_union.prefetch(next_id);
+        markers.prefetch(next_id);
+    }
 
     virtual void preprocess_edge(VertexPtr u, VertexPtr v);
     virtual void postprocess_edge(VertexPtr u, VertexPtr v);
 
     virtual void algorithm_step(VertexPtr u, VertexPtr v) = 0;
 
+    // Inserts an edge which can't close a cycle, since its target is
+    // a single vertex without outgoing edges or its source is a single vertex
+    // without incoming edges. Returns false if the algorithm has no cheaper
+    // way to do it than the full `algorithm_step`.
+    virtual bool insert_without_search(const VertexPtr &, const VertexPtr &) {
+        return false;
+    }
+    // Components of at least two vertices have both incoming and outgoing
+    // edges, so only single vertices can be sinks or sources. Both are valid
+    // only with the prefilter.
+    bool is_sink(Vertex_id_t u) const {
+        return !incidence_markers.is_marked(u, HAS_OUT_EDGE) &&
+               find_union.is_singleton(u);
+    }
+    bool is_source(Vertex_id_t u) const {
+        return !incidence_markers.is_marked(u, HAS_IN_EDGE) &&
+               find_union.is_singleton(u);
+    }
+
+    // Order in which searches are expected to visit vertices, e.g.
+    // a topological order of the components. If empty, the order of ids.
+    virtual std::vector<Vertex_id_t> get_locality_order() { return {}; }
+    // Representatives of the components sorted by `key(id)`.
+    template <typename Key>
+    std::vector<Vertex_id_t> sort_representatives(Key key) {
+        std::vector<std::pair<decltype(key(0)), Vertex_id_t>> keyed;
+        for (Vertex_id_t id = 0; id < graph.get_no_vertices(); id++) {
+            if (find_union.find_representant(id) == id)
+                keyed.emplace_back(key(id), id);
+        }
+        std::ranges::sort(keyed);
+
+        std::vector<Vertex_id_t> sorted;
+        sorted.reserve(keyed.size());
+        for (const auto &[_, id] : keyed)
+            sorted.push_back(id);
+        return sorted;
+    }
+    // Lays out adjacency lists in memory in the locality order, so that
+    // searches following it scan records nearly sequentially. With
+    // renumbering, vertices of the locality order also get consecutive ids,
+    // so that per-vertex arrays are scanned nearly sequentially as well.
+    virtual void reorder_adjacency();
+    // Whether the algorithm keeps no per-vertex state between edges other
+    // than what `renumber_vertices` permutes.
+    virtual bool supports_renumbering() const { return false; }
+    // Gives vertex u the id new_ids[u]. Algorithms supporting renumbering
+    // have to permute their own per-vertex state as well.
+    virtual void renumber_vertices(const std::vector<Vertex_id_t> &new_ids);
+
+    // Inserts a single edge, used by `run`.
+    void process_edge(const VertexPtr &u, const VertexPtr &v);
+
    public:
     explicit Algorithm(size_t no_vertices)
-        : graph(no_vertices), find_union(no_vertices) {}
+        : graph(no_vertices),
+          find_union(no_vertices),
+          compaction_markers(no_vertices) {}
 
     virtual ~Algorithm() = default;
 
+    // Stores `graph` compressed, see EdgeStore. Has to be called before any
+    // edge is processed.
+    void compress_adjacency();
+    // Calls `reorder_adjacency` every `no_edges` processed edges.
+    void reorder_adjacency_every(size_t no_edges) { reorder_every = no_edges; }
+    // Renumbers vertices whenever adjacency lists are reordered. Throws if
+    // the algorithm doesn't support it.
+    void enable_renumbering();
+    // Inserts edges which can't close a cycle with `insert_without_search`.
+    // Has to be called before any edge is processed.
+    void enable_prefilter();
+    // Skips edges whose endpoints are already in one component, before any
+    // work of the algorithm.
+    void drop_same_component_edges() { drop_same_component = true; }
+
+    // Appends a new isolated vertex and returns it. Algorithms which keep
+    // their own per-vertex state have to extend it as well.
+    virtual VertexPtr add_vertex();
+
     virtual void run(const Raw_edges_list &edges);
 
-    void print_sccs(size_t original_no_vertices);
+    // Prints how many edges were inserted without a search or dropped.
+    void print_stats(std::ostream &out) const;
+
+    // Prints components of the first `original_no_vertices` vertices.
+    // If the input was relabeled, `new_ids` maps input ids to the ones given
+    // to `run`, and the input ids are printed.
+    void print_sccs(size_t original_no_vertices,
+                    const std::vector<Vertex_id_t> &new_ids = {});
 };
 
 #endif  // ALGORITHM_HPP
@@ -5,81 +5,173 @@
 #include "bender/naive_one_way_search.hpp"
 #include "bender/one_way_search.hpp"
 #include "bender/two_way_search.hpp"
+#include "bernstein/bernstein_chechik_search.hpp"
 #include "bernstein/sample_search.hpp"
 #include "haeupler/compatible_search.hpp"
 #include "haeupler/limited_search.hpp"
 #include "haeupler/soft_threshold_search.hpp"
 #include "haeupler/topological_search.hpp"
 #include "naive/naive_dfs.hpp"
+#include "pearce/pearce_kelly_search.hpp"
+#include "sparsified.hpp"
 
-using AlgorithmFactory = std::function<std::unique_ptr<Algorithm>(size_t)>;
+using AlgorithmFactory = std::function<std::unique_ptr<Algorithm>(
+    size_t, size_t, const AlgorithmOptions&)>;
 using AlgorithmFactoryMap = std::unordered_map<std::string, AlgorithmFactory>;
 
+namespace {
+
+// Creates `Base` running on the graph sparsified with SimpleGraphSparsifier.
+// `base_args` are passed to the `Base` constructor after the number of
+// vertices.
+template <typename Base, typename... BaseArgs>
+std::unique_ptr<Algorithm> create_simple_sparsified(size_t no_vertices,
+                                                    BaseArgs&&... base_args) {
+    return std::make_unique<SimpleSparsified<Base>>(
+        no_vertices, SimpleGraphSparsifierForward(no_vertices), no_vertices,
+        std::forward<BaseArgs>(base_args)...);
+}
+
+// Same as above, but uses AdvancedGraphSparsifier.
+template <typename Base, typename... BaseArgs>
+std::unique_ptr<Algorithm> create_advanced_sparsified(size_t no_vertices,
+                                                      size_t no_edges,
+                                                      BaseArgs&&... base_args) {
+    return std::make_unique<AdvancedSparsified<Base>>(
+        no_vertices, AdvancedGraphSparsifierForward(no_vertices, no_edges),
+        no_vertices, std::forward<BaseArgs>(base_args)...);
+}
+
+}  // namespace
+
 std::unique_ptr<Algorithm> create_algorithm(const std::string& algorithm_name,
-                                            size_t no_vertices) {
+                                            size_t no_vertices, size_t no_edges,
+                                            const AlgorithmOptions& options) {
     static const AlgorithmFactoryMap algorithm_creators = {
         {"naive_dfs",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<NaiveDfs>(no_vertices_);
          }},
         {"naive_one_way_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<NaiveOneWaySearch>(no_vertices_);
          }},
         {"one_way_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<OneWaySearch>(no_vertices_);
          }},
         {"two_way_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<TwoWaySearch>(no_vertices_);
          }},
+        {"pearce_kelly_search",
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
+             return std::make_unique<PearceKellySearch>(no_vertices_);
+         }},
         {"limited_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<LimitedSearch>(no_vertices_);
          }},
         {"compatible_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              auto order = std::make_shared<DynamicOrderList>(no_vertices_);
              return std::make_unique<CompatibleSearch>(no_vertices_, order);
          }},
         {"soft_threshold_search_basic_list",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              auto order = std::make_shared<DynamicOrderBasicList>(no_vertices_);
              return std::make_unique<SoftThresholdSearch>(no_vertices_, order);
          }},
         {"soft_threshold_search_treap",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              auto order = std::make_shared<DynamicOrderTreap>(no_vertices_);
              return std::make_unique<SoftThresholdSearch>(no_vertices_, order);
          }},
         {"soft_threshold_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              auto order = std::make_shared<DynamicOrderList>(no_vertices_);
              return std::make_unique<SoftThresholdSearch>(no_vertices_, order);
          }},
         {"topological_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
              return std::make_unique<TopologicalSearch>(no_vertices_);
          }},
         {"sample_search",
-         [](size_t no_vertices_) {
+         [](size_t no_vertices_, size_t, const AlgorithmOptions& options_) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return std::make_unique<SampleSearch>(no_vertices_, order,
+                                                   options_.sample_size);
+         }},
+        {"sparsified_two_way_search",
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
+             return create_simple_sparsified<TwoWaySearch>(no_vertices_);
+         }},
+        {"advanced_sparsified_two_way_search",
+         [](size_t no_vertices_, size_t no_edges_, const AlgorithmOptions&) {
+             return create_advanced_sparsified<TwoWaySearch>(no_vertices_,
+                                                             no_edges_);
+         }},
+        {"sparsified_compatible_search",
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_simple_sparsified<CompatibleSearch>(no_vertices_,
+                                                               order);
+         }},
+        {"advanced_sparsified_compatible_search",
+         [](size_t no_vertices_, size_t no_edges_, const AlgorithmOptions&) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_advanced_sparsified<CompatibleSearch>(
+                 no_vertices_, no_edges_, order);
+         }},
+        {"sparsified_soft_threshold_search",
+         [](size_t no_vertices_, size_t, const AlgorithmOptions&) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_simple_sparsified<SoftThresholdSearch>(no_vertices_,
+                                                                  order);
+         }},
+        {"advanced_sparsified_soft_threshold_search",
+         [](size_t no_vertices_, size_t no_edges_, const AlgorithmOptions&) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_advanced_sparsified<SoftThresholdSearch>(
+                 no_vertices_, no_edges_, order);
+         }},
+        {"sparsified_sample_search",
+         [](size_t no_vertices_, size_t, const AlgorithmOptions& options_) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_simple_sparsified<SampleSearch>(
+                 no_vertices_, order, options_.sample_size, no_vertices_);
+         }},
+        {"advanced_sparsified_sample_search",
+         [](size_t no_vertices_, size_t no_edges_,
+            const AlgorithmOptions& options_) {
+             auto order = std::make_shared<DynamicOrderList>(no_vertices_);
+             return create_advanced_sparsified<SampleSearch>(
+                 no_vertices_, no_edges_, order, options_.sample_size,
+                 no_vertices_);
+         }},
+        {"bernstein_chechik_search",
+         [](size_t no_vertices_, size_t no_edges_,
+            const AlgorithmOptions& options_) {
              auto order = std::make_shared<DynamicOrderList>(no_vertices_);
-             return std::make_unique<SampleSearch>(no_vertices_, order);
-         }},
-        {"sparsified_sample_search", [](size_t no_vertices_) {
-             const auto updated_no_vertices =
-                 SimpleGraphSparsifier::get_updated_no_of_vertices(
-                     no_vertices_);
-             auto order =
-                 std::make_shared<DynamicOrderList>(updated_no_vertices);
-             return std::make_unique<SparsifiedSampleSearch>(
-                 updated_no_vertices, no_vertices_, order);
+             return create_advanced_sparsified<BernsteinChechikSearch>(
+                 no_vertices_, no_edges_, order,
+                 options_.bernstein_chechik_sample_size, no_vertices_);
          }}};
 
     const auto algorithm_creator = algorithm_creators.find(algorithm_name);
     if (algorithm_creator != algorithm_creators.end()) {
-        return algorithm_creator->second(no_vertices);
+        auto algorithm =
+            algorithm_creator->second(no_vertices, no_edges, options);
+        if (options.compressed_adjacency)
+            algorithm->compress_adjacency();
+        algorithm->reorder_adjacency_every(options.reorder_every);
+        if (options.renumber)
+            algorithm->enable_renumbering();
+        if (options.prefilter)
+            algorithm->enable_prefilter();
+        if (options.drop_same_component)
+            algorithm->drop_same_component_edges();
+        return algorithm;
     }
 
     throw std::runtime_error("Unknown algorithm: " + algorithm_name);
@@ -4,9 +4,12 @@
 #include <memory>
 
 #include "algorithm.hpp"
+#include "algorithm_options.hpp"
 
 // Given an algorithm name creates a corresponding Algorithm object.
-std::unique_ptr<Algorithm> create_algorithm(const std::string& algorithm_name,
-                                            size_t no_vertices);
+// `no_edges` is the number of edges that are going to be inserted.
+std::unique_ptr<Algorithm> create_algorithm(
+    const std::string& algorithm_name, size_t no_vertices, size_t no_edges,
+    const AlgorithmOptions& options = {});
 
 #endif  // ALGORITHM_FACTORY_HPP
@@ -0,0 +1,33 @@
+#ifndef ALGORITHM_OPTIONS_HPP
+#define ALGORITHM_OPTIONS_HPP
+
+#include <cstddef>
+#include <optional>
+
+// Parameters of algorithms which can be set from the command line.
+struct AlgorithmOptions {
+    static constexpr size_t DEFAULT_SAMPLE_SIZE = 2;
+    // BernsteinChechikSearch searches only within partitions, which shrink as
+    // the sample grows, so it samples more vertices.
+    static constexpr size_t DEFAULT_BERNSTEIN_CHECHIK_SAMPLE_SIZE = 16;
+
+    // Number of vertices sampled by SampleSearch and BernsteinChechikSearch.
+    // If not set, the sample grows with the number of processed edges.
+    std::optional<size_t> sample_size = DEFAULT_SAMPLE_SIZE;
+    std::optional<size_t> bernstein_chechik_sample_size =
+        DEFAULT_BERNSTEIN_CHECHIK_SAMPLE_SIZE;
+    // Trades speed of traversals for the memory used by adjacency lists.
+    bool compressed_adjacency = false;
+    // Number of edges after which adjacency lists are laid out in memory
+    // again, following the order maintained by the algorithm. 0 disables it.
+    size_t reorder_every = 0;
+    // Together with `reorder_every`, also gives the vertices ids following
+    // the order maintained by the algorithm.
+    bool renumber = false;
+    // Inserts edges which can't close a cycle without searching.
+    bool prefilter = false;
+    // Skips edges whose endpoints are already in one component.
+    bool drop_same_component = false;
+};
+
+#endif  // ALGORITHM_OPTIONS_HPP
@@ -0,0 +1,80 @@
+#include "bitset.hpp"
+
+#include <cstring>
+#include <new>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+size_t bitset_no_words(size_t no_bits) {
+    const auto no_lines =
+        (no_bits + BITSET_WORDS_PER_LINE * BITSET_WORD_BITS - 1) /
+        (BITSET_WORDS_PER_LINE * BITSET_WORD_BITS);
+    return no_lines * BITSET_WORDS_PER_LINE;
+}
+
+AlignedWords::AlignedWords(size_t no_words) {
+    if (no_words == 0)
+        return;
+    const auto no_bytes = no_words * sizeof(Bitset_word_t);
+    auto* memory = std::aligned_alloc(BITSET_ALIGNMENT, no_bytes);
+    if (!memory)
+        throw std::bad_alloc();
+    std::memset(memory, 0, no_bytes);
+    words.reset(static_cast<Bitset_word_t*>(memory));
+}
+
+void bitset_or(Bitset_word_t* dst, const Bitset_word_t* src, size_t no_words) {
+#if defined(__AVX2__)
+    for (size_t i = 0; i < no_words; i += 4) {
+        auto* d = reinterpret_cast<__m256i*>(dst + i);
+        const auto* s = reinterpret_cast<const __m256i*>(src + i);
+        _mm256_store_si256(
+            d, _mm256_or_si256(_mm256_load_si256(d), _mm256_load_si256(s)));
+    }
+#elif defined(__SSE2__)
+    for (size_t i = 0; i < no_words; i += 2) {
+        auto* d = reinterpret_cast<__m128i*>(dst + i);
+        const auto* s = reinterpret_cast<const __m128i*>(src + i);
+        _mm_store_si128(d, _mm_or_si128(_mm_load_si128(d), _mm_load_si128(s)));
+    }
+#else
+    for (size_t i = 0; i < no_words; i++)
+        dst[i] |= src[i];
+#endif
+}
+
+bool bitset_intersects(const Bitset_word_t* a, const Bitset_word_t* b,
+                       size_t no_words) {
+#if defined(__AVX2__)
+    for (size_t i = 0; i < no_words; i += 4) {
+        const auto x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        const auto y = _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (!_mm256_testz_si256(x, y))
+            return true;
+    }
+    return false;
+#elif defined(__SSE2__)
+    const auto zero = _mm_setzero_si128();
+    for (size_t i = 0; i < no_words; i += BITSET_WORDS_PER_LINE) {
+        auto acc = zero;
+        for (size_t j = i; j < i + BITSET_WORDS_PER_LINE; j += 2) {
+            const auto x =
+                _mm_load_si128(reinterpret_cast<const __m128i*>(a + j));
+            const auto y =
+                _mm_load_si128(reinterpret_cast<const __m128i*>(b + j));
+            acc = _mm_or_si128(acc, _mm_and_si128(x, y));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+            return true;
+    }
+    return false;
+#else
+    for (size_t i = 0; i < no_words; i++) {
+        if (a[i] & b[i])
+            return true;
+    }
+    return false;
+#endif
+}
@@ -0,0 +1,70 @@
+#ifndef BITSET_HPP
+#define BITSET_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+// Bit containers whose rows start at 64-byte boundaries and span a whole
+// number of cache lines, so word-wise operations may use aligned SIMD loads
+// without handling tails.
+using Bitset_word_t = uint64_t;
+
+constexpr size_t BITSET_WORD_BITS = 64;
+constexpr size_t BITSET_ALIGNMENT = 64;
+constexpr size_t BITSET_WORDS_PER_LINE =
+    BITSET_ALIGNMENT / sizeof(Bitset_word_t);
+
+// Number of words needed to store `no_bits` bits, rounded up to whole lines.
+size_t bitset_no_words(size_t no_bits);
+
+// dst |= src
+void bitset_or(Bitset_word_t* dst, const Bitset_word_t* src, size_t no_words);
+// Returns if (a & b) != 0.
+bool bitset_intersects(const Bitset_word_t* a, const Bitset_word_t* b,
+                       size_t no_words);
+
+class AlignedWords {
+   private:
+    struct Deleter {
+        void operator()(Bitset_word_t* words) const { std::free(words); }
+    };
+
+    std::unique_ptr<Bitset_word_t[], Deleter> words;
+
+   public:
+    AlignedWords() = default;
+    explicit AlignedWords(size_t no_words);
+
+    Bitset_word_t* get() const { return words.get(); }
+};
+
+class Bitset {
+   private:
+    size_t no_words = 0;
+    AlignedWords words;
+
+   public:
+    Bitset() = default;
+    explicit Bitset(size_t no_bits)
+        : no_words(bitset_no_words(no_bits)), words(no_words) {}
+
+    bool get(size_t i) const {
+        return (words.get()[i / BITSET_WORD_BITS] >> (i % BITSET_WORD_BITS)) &
+               1;
+    }
+    void set(size_t i) {
+        words.get()[i / BITSET_WORD_BITS] |= Bitset_word_t{1}
+                                             << (i % BITSET_WORD_BITS);
+    }
+    void reset(size_t i) {
+        words.get()[i / BITSET_WORD_BITS] &=
+            ~(Bitset_word_t{1} << (i % BITSET_WORD_BITS));
+    }
+
+    size_t get_no_words() const { return no_words; }
+    Bitset_word_t* data() { return words.get(); }
+    const Bitset_word_t* data() const { return words.get(); }
+};
+
+#endif  // BITSET_HPP
@@ -4,42 +4,54 @@
 #include <stdexcept>
 
 namespace {
-template <typename T>
-void assure_element_exists(Element_t x,
-                           const std::vector<std::optional<T>>& elements) {
-    if (!elements[x].has_value())
+void assure_element_exists(Element_t x, bool exists) {
+    if (!exists)
         throw std::invalid_argument("Element does not exist: " +
                                     std::to_string(x));
 }
 
-template <typename T>
-void assure_element_does_not_exist(
-    Element_t x, const std::vector<std::optional<T>>& elements) {
-    if (elements[x].has_value())
+void assure_element_does_not_exist(Element_t x, bool exists) {
+    if (exists)
         throw std::invalid_argument("Element already exists: " +
                                     std::to_string(x));
 }
+
+template <typename T>
+void assure_element_exists(Element_t x,
+                           const Huge_page_vector<std::optional<T>>& elements) {
+    assure_element_exists(x, elements[x].has_value());
+}
+
+template <typename T>
+void assure_element_does_not_exist(
+    Element_t x, const Huge_page_vector<std::optional<T>>& elements) {
+    assure_element_does_not_exist(x, elements[x].has_value());
+}
 }  // namespace
 
 void DynamicOrderBasicList::insert_back(Element_t x) {
+    version++;
     assure_element_does_not_exist(x, element_pointers);
     order.push_back(x);
     element_pointers[x] = std::prev(order.end());
 }
 
 void DynamicOrderBasicList::insert_before(Element_t x, Element_t y) {
+    version++;
     assure_element_does_not_exist(x, element_pointers);
     assure_element_exists(y, element_pointers);
     element_pointers[x] = order.insert(*element_pointers[y], x);
 }
 
 void DynamicOrderBasicList::insert_after(Element_t x, Element_t y) {
+    version++;
     assure_element_does_not_exist(x, element_pointers);
     assure_element_exists(y, element_pointers);
     element_pointers[x] = order.insert(std::next(*element_pointers[y]), x);
 }
 
 void DynamicOrderBasicList::remove(Element_t x) {
+    version++;
     assure_element_exists(x, element_pointers);
     order.erase(*element_pointers[x]);
     element_pointers[x] = std::nullopt;
@@ -57,6 +69,15 @@ bool DynamicOrderBasicList::is_before(Element_t x, Element_t y) const {
     return false;
 }
 
+Order_key_t DynamicOrderBasicList::order_key(Element_t x) const {
+    assure_element_exists(x, element_pointers);
+
+    size_t position = 0;
+    for (auto iter = order.begin(); iter != *element_pointers[x]; ++iter)
+        position++;
+    return {position, 0};
+}
+
 size_t DynamicOrderBasicList::total_elements_capacity() {
     return element_pointers.size();
 }
@@ -72,6 +93,14 @@ Element_t DynamicOrderBasicList::first_element() {
     return *order.begin();
 }
 
+std::optional<Element_t> DynamicOrderBasicList::next_element(Element_t x) {
+    assure_element_exists(x, element_pointers);
+    const auto next = std::next(*element_pointers[x]);
+    if (next == order.end())
+        return std::nullopt;
+    return *next;
+}
+
 size_t DynamicOrderTreap::get_size(const Node* node) {
     return node ? node->size : 0;
 }
@@ -148,6 +177,7 @@ void DynamicOrderTreap::insert_at_position(Element_t x, size_t position) {
 }
 
 void DynamicOrderTreap::insert_back(Element_t x) {
+    version++;
     assure_element_does_not_exist(x, nodes);
     auto* node = new Node(x);
     nodes[x] = node;
@@ -155,18 +185,21 @@ void DynamicOrderTreap::insert_back(Element_t x) {
 }
 
 void DynamicOrderTreap::insert_before(Element_t x, Element_t y) {
+    version++;
     assure_element_does_not_exist(x, nodes);
     assure_element_exists(y, nodes);
     insert_at_position(x, get_rank(*nodes[y]) - 1);
 }
 
 void DynamicOrderTreap::insert_after(Element_t x, Element_t y) {
+    version++;
     assure_element_does_not_exist(x, nodes);
     assure_element_exists(y, nodes);
     insert_at_position(x, get_rank(*nodes[y]));
 }
 
 void DynamicOrderTreap::remove(Element_t x) {
+    version++;
     assure_element_exists(x, nodes);
     const auto node_x = *nodes[x];
     const auto pos = get_rank(node_x) - 1;
@@ -184,6 +217,11 @@ bool DynamicOrderTreap::is_before(Element_t x, Element_t y) const {
     return get_rank(*nodes[x]) < get_rank(*nodes[y]);
 }
 
+Order_key_t DynamicOrderTreap::order_key(Element_t x) const {
+    assure_element_exists(x, nodes);
+    return {get_rank(*nodes[x]), 0};
+}
+
 size_t DynamicOrderTreap::total_elements_capacity() { return nodes.size(); }
 
 void DynamicOrderTreap::extend_elements_capacity() {
@@ -197,81 +235,97 @@ Element_t DynamicOrderTreap::first_element() {
     return node->value;
 }
 
-std::shared_ptr<DynamicOrderList::UpperNode>
-DynamicOrderList::UpperNode::insert_after() {
-    auto current_node = next;
-    size_t j = 1;
-    for (; current_node && current_node->label - label <= j * j;
-         ++j, current_node = current_node->next) {
+std::optional<Element_t> DynamicOrderTreap::next_element(Element_t x) {
+    assure_element_exists(x, nodes);
+    auto node = *nodes[x];
+    if (node->right) {
+        node = node->right;
+        while (node->left)
+            node = node->left;
+        return node->value;
     }
-    size_t mul = ceil(MAX_LABEL - 1 - label, j);
-    if (current_node)
-        mul = ceil(current_node->label - label, j);
-
-    current_node = next;
-    for (size_t k = 1; k < j; ++k, current_node = current_node->next)
-        current_node->label = label + mul * k;
-
-    const Label_t new_label = ceil(label + next->label, 2);
-    auto result =
-        std::make_shared<UpperNode>(new_label, next, shared_from_this());
-    next->prev = result;
-    next = result;
-    return result;
+    while (node->parent && node == node->parent->right)
+        node = node->parent;
+    if (!node->parent)
+        return std::nullopt;
+    return node->parent->value;
 }
 
-void DynamicOrderList::UpperNode::remove() {
-    const auto prev_node = prev.lock();
-    if (prev_node) {
-        if (next)
-            next->prev = prev_node;
-        prev_node->next = next;
+DynamicOrderList::Node_id_t DynamicOrderList::insert_upper_after(
+    Node_id_t node) {
+    const auto label = upper_nodes[node].label;
+    auto current_node = upper_nodes[node].next;
+    size_t j = 1;
+    for (; current_node != NO_NODE &&
+           upper_nodes[current_node].label - label <= j * j;
+         ++j, current_node = upper_nodes[current_node].next) {
     }
-    next = nullptr;
-    prev.reset();
+    size_t mul = ceil(MAX_LABEL - 1 - label, j);
+    if (current_node != NO_NODE)
+        mul = ceil(upper_nodes[current_node].label - label, j);
+
+    current_node = upper_nodes[node].next;
+    for (size_t k = 1; k < j; ++k, current_node = upper_nodes[current_node].next)
+        upper_nodes[current_node].label = label + mul * k;
+
+    const auto next = upper_nodes[node].next;
+    const UpperNode result_node{ceil(label + upper_nodes[next].label, 2), next,
+                                node};
+    Node_id_t result;
+    if (free_upper_nodes.empty()) {
+        result = upper_nodes.size();
+        upper_nodes.push_back(result_node);
+    } else {
+        result = free_upper_nodes.back();
+        free_upper_nodes.pop_back();
+        upper_nodes[result] = result_node;
+    }
+    upper_nodes[next].prev = result;
+    upper_nodes[node].next = result;
+    return result;
 }
 
-int DynamicOrderList::UpperNode::compare(
-    const std::shared_ptr<UpperNode>& other) const {
-    if (label < other->label)
-        return -1;
-    if (label > other->label)
-        return 1;
-    return 0;
+void DynamicOrderList::remove_upper(Node_id_t node) {
+    const auto [label, next, prev] = upper_nodes[node];
+    if (prev == NO_NODE)
+        return;
+    if (next != NO_NODE)
+        upper_nodes[next].prev = prev;
+    upper_nodes[prev].next = next;
+    free_upper_nodes.push_back(node);
 }
 
-std::shared_ptr<DynamicOrderList::LowerNode>
-DynamicOrderList::LowerNode::insert_after(Element_t next_value) {
+void DynamicOrderList::insert_lower_after(Node_id_t node, Node_id_t new_node) {
+    const auto [label, next, prev, parent] = lower_nodes[node];
     auto next_label = MAX_LABEL;
-    const auto self = shared_from_this();
-    const auto result =
-        std::make_shared<LowerNode>(0, next, self, parent, next_value);
-    if (next) {
-        next->prev = result;
-        if (parent == next->parent)
-            next_label = next->label;
+    lower_nodes[new_node] = {0, next, node, parent};
+    if (next != NO_NODE) {
+        lower_nodes[next].prev = new_node;
+        if (lower_nodes[next].parent == parent)
+            next_label = lower_nodes[next].label;
     }
-    next = result;
+    lower_nodes[node].next = new_node;
 
     if (next_label != label + 1) {
-        result->label = std::min((label + next_label) / 2, label + LOG_MAX);
-        return result;
+        lower_nodes[new_node].label =
+            std::min((label + next_label) / 2, label + LOG_MAX);
+        return;
     }
 
     size_t nodes_with_same_parent = 1;
-    auto begin = self;
-    while (const auto prev_node = begin->prev.lock()) {
-        if (prev_node->parent != parent)
-            break;
-        begin = prev_node;
+    auto begin = node;
+    while (lower_nodes[begin].prev != NO_NODE &&
+           lower_nodes[lower_nodes[begin].prev].parent == parent) {
+        begin = lower_nodes[begin].prev;
         nodes_with_same_parent++;
     }
-    auto end = self;
-    while (end->next && end->next->parent == parent) {
-        end = end->next;
+    auto end = node;
+    while (lower_nodes[end].next != NO_NODE &&
+           lower_nodes[lower_nodes[end].next].parent == parent) {
+        end = lower_nodes[end].next;
         nodes_with_same_parent++;
     }
-    end = end->next;
+    end = lower_nodes[end].next;
 
     auto current_node = begin;
     auto current_parent = parent;
@@ -284,79 +338,108 @@ DynamicOrderList::LowerNode::insert_after(Element_t next_value) {
              current_label < MAX_LABEL && processed < LOG_MAX;
              current_label += step_size, ++processed) {
             if (current_node == end)
-                return result;
-            current_node->label = current_label;
-            current_node->parent = current_parent;
-            current_node = current_node->next;
+                return;
+            lower_nodes[current_node].label = current_label;
+            lower_nodes[current_node].parent = current_parent;
+            current_node = lower_nodes[current_node].next;
             nodes_with_same_parent--;
         }
 
         if (current_node == end)
-            return result;
-        current_parent = current_parent->insert_after();
+            return;
+        current_parent = insert_upper_after(current_parent);
     }
 }
 
-void DynamicOrderList::LowerNode::remove() const {
+void DynamicOrderList::remove_lower(Node_id_t node) {
+    const auto [label, next, prev, parent] = lower_nodes[node];
     bool unique_parent = true;
-    if (next) {
-        next->prev = prev;
-        unique_parent = next->parent != parent;
+    if (next != NO_NODE) {
+        lower_nodes[next].prev = prev;
+        unique_parent = lower_nodes[next].parent != parent;
     }
-    if (const auto prev_node = prev.lock()) {
-        prev_node->next = next;
-        unique_parent &= prev_node->parent != parent;
+    if (prev != NO_NODE) {
+        lower_nodes[prev].next = next;
+        unique_parent &= lower_nodes[prev].parent != parent;
     }
-    if (unique_parent && parent)
-        parent->remove();
-}
-
-int DynamicOrderList::LowerNode::compare(
-    const std::shared_ptr<LowerNode>& other) const {
-    const auto parent_compare = parent->compare(other->parent);
-    if (parent_compare)
-        return parent_compare;
-    if (label < other->label)
+    if (unique_parent)
+        remove_upper(parent);
+    lower_nodes[node] = {0, NO_NODE, NO_NODE, NO_NODE};
+}
+
+int DynamicOrderList::compare(Node_id_t x, Node_id_t y) const {
+    const auto& node_x = lower_nodes[x];
+    const auto& node_y = lower_nodes[y];
+    const auto parent_x = upper_nodes[node_x.parent].label;
+    const auto parent_y = upper_nodes[node_y.parent].label;
+    if (parent_x != parent_y)
+        return parent_x < parent_y ? -1 : 1;
+    if (node_x.label < node_y.label)
         return -1;
-    if (label > other->label)
+    if (node_x.label > node_y.label)
         return 1;
     return 0;
 }
 
+bool DynamicOrderList::contains(Element_t x) const {
+    return lower_nodes[x + ELEMENTS_OFFSET].parent != NO_NODE;
+}
+
 void DynamicOrderList::insert_back(Element_t x) {
-    assure_element_does_not_exist(x, nodes);
-    nodes[x] = tail->prev.lock()->insert_after(x);
+    version++;
+    assure_element_does_not_exist(x, contains(x));
+    insert_lower_after(lower_nodes[TAIL].prev, x + ELEMENTS_OFFSET);
 }
 
 void DynamicOrderList::insert_before(Element_t x, Element_t y) {
-    assure_element_does_not_exist(x, nodes);
-    assure_element_exists(y, nodes);
-    const auto node_y = *nodes[y];
-    nodes[x] = node_y->prev.lock()->insert_after(x);
+    version++;
+    assure_element_does_not_exist(x, contains(x));
+    assure_element_exists(y, contains(y));
+    insert_lower_after(lower_nodes[y + ELEMENTS_OFFSET].prev,
+                       x + ELEMENTS_OFFSET);
 }
 
 void DynamicOrderList::insert_after(Element_t x, Element_t y) {
-    assure_element_does_not_exist(x, nodes);
-    assure_element_exists(y, nodes);
-    nodes[x] = (*nodes[y])->insert_after(x);
+    version++;
+    assure_element_does_not_exist(x, contains(x));
+    assure_element_exists(y, contains(y));
+    insert_lower_after(y + ELEMENTS_OFFSET, x + ELEMENTS_OFFSET);
 }
 
 void DynamicOrderList::remove(Element_t x) {
-    assure_element_exists(x, nodes);
-    (*nodes[x])->remove();
-    nodes[x] = std::nullopt;
+    version++;
+    assure_element_exists(x, contains(x));
+    remove_lower(x + ELEMENTS_OFFSET);
 }
 
 bool DynamicOrderList::is_before(Element_t x, Element_t y) const {
-    assure_element_exists(x, nodes);
-    assure_element_exists(y, nodes);
-    return (*nodes[x])->compare(*nodes[y]) < 0;
+    assure_element_exists(x, contains(x));
+    assure_element_exists(y, contains(y));
+    return compare(x + ELEMENTS_OFFSET, y + ELEMENTS_OFFSET) < 0;
 }
 
-size_t DynamicOrderList::total_elements_capacity() { return nodes.size(); }
+Order_key_t DynamicOrderList::order_key(Element_t x) const {
+    assure_element_exists(x, contains(x));
+    const auto& node = lower_nodes[x + ELEMENTS_OFFSET];
+    return {upper_nodes[node.parent].label, node.label};
+}
+
+size_t DynamicOrderList::total_elements_capacity() {
+    return lower_nodes.size() - ELEMENTS_OFFSET;
+}
 
 void DynamicOrderList::extend_elements_capacity() {
-    nodes.emplace_back(std::nullopt);
+    lower_nodes.push_back({0, NO_NODE, NO_NODE, NO_NODE});
 }
 
-size_t DynamicOrderList::first_element() { return head->next->value; }
+Element_t DynamicOrderList::first_element() {
+    return lower_nodes[HEAD].next - ELEMENTS_OFFSET;
+}
+
+std::optional<Element_t> DynamicOrderList::next_element(Element_t x) {
+    assure_element_exists(x, contains(x));
+    const auto next = lower_nodes[x + ELEMENTS_OFFSET].next;
+    if (next == TAIL)
+        return std::nullopt;
+    return next - ELEMENTS_OFFSET;
+}
@@ -1,6 +1,7 @@
 #ifndef DYNAMIC_ORDER_HPP
 #define DYNAMIC_ORDER_HPP
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <optional>
@@ -8,10 +9,13 @@
 #include <vector>
 
 #include "find_union.hpp"
+#include "huge_pages.hpp"
 #include "rng.hpp"
 
 using Element_t = size_t;
 using Element_list = std::list<Element_t>;
+// Key of an element that can be compared instead of calling `is_before`.
+using Order_key_t = std::pair<size_t, size_t>;
 
 // Interface of a data structure that represents a list of distinct integers and
 // allows to:
@@ -20,6 +24,10 @@ using Element_list = std::list<Element_t>;
 // 3. Ask about the relative order of element x and y.
 //    (that is, whether x occurs before or after y in the list).
 class DynamicOrder {
+   protected:
+    // Increased on every modification of the order.
+    size_t version = 0;
+
    public:
     DynamicOrder() = default;
     virtual ~DynamicOrder() = default;
@@ -35,11 +43,20 @@ class DynamicOrder {
     // Does x occur before y in the data structure.
     virtual bool is_before(Element_t x, Element_t y) const = 0;
 
+    // Returns a key such that x is before y iff order_key(x) < order_key(y).
+    // Keys remain valid only until the next modification, which can be
+    // detected by comparing the results of `get_version`.
+    virtual Order_key_t order_key(Element_t x) const = 0;
+    size_t get_version() const { return version; }
+
     // Returns the maximum potential number of elements that could be present
     // in the list at the same time.
     virtual size_t total_elements_capacity() = 0;
     virtual void extend_elements_capacity() = 0;
     virtual Element_t first_element() = 0;
+    // Returns the element following x, if any. Walking the whole order this
+    // way takes linear time.
+    virtual std::optional<Element_t> next_element(Element_t x) = 0;
 };
 
 using DynamicOrderPtr = std::shared_ptr<DynamicOrder>;
@@ -55,28 +72,11 @@ struct DynamicOrderComparator {
     }
 };
 
-struct FindUnionDynamicOrderComparator {
-    const DynamicOrderPtr dynamic_order;
-    std::reference_wrapper<const FindUnion> find_union;
-
-    FindUnionDynamicOrderComparator(DynamicOrderPtr dynamic_order,
-                                    const FindUnion& find_union)
-        : dynamic_order(std::move(dynamic_order)), find_union(find_union) {}
-
-    bool operator()(Element_t x, Element_t y) const {
-        const auto x_repr = find_union.get().find_representant(x);
-        const auto y_repr = find_union.get().find_representant(y);
-        if (x_repr == y_repr)
-            return x < y;
-        return dynamic_order->is_before(x_repr, y_repr);
-    }
-};
-
 // Trivial implementation on list, operation 3 has pessimistic O(n) complexity.
 class DynamicOrderBasicList : public DynamicOrder {
    private:
     Element_list order;
-    std::vector<std::optional<Element_list::iterator>> element_pointers;
+    Huge_page_vector<std::optional<Element_list::iterator>> element_pointers;
 
    public:
     explicit DynamicOrderBasicList(size_t no_elements)
@@ -92,10 +92,12 @@ class DynamicOrderBasicList : public DynamicOrder {
     void remove(Element_t x) override;
 
     bool is_before(Element_t x, Element_t y) const override;
+    Order_key_t order_key(Element_t x) const override;
 
     size_t total_elements_capacity() override;
     void extend_elements_capacity() override;
     Element_t first_element() override;
+    std::optional<Element_t> next_element(Element_t x) override;
 };
 
 class DynamicOrderTreap : public DynamicOrder {
@@ -115,7 +117,7 @@ class DynamicOrderTreap : public DynamicOrder {
     };
 
     Node* root;
-    std::vector<std::optional<Node*>> nodes;
+    Huge_page_vector<std::optional<Node*>> nodes;
 
     static size_t get_size(const Node* node);
     static size_t get_rank(const Node* node);
@@ -149,88 +151,67 @@ class DynamicOrderTreap : public DynamicOrder {
     void remove(Element_t x) override;
 
     bool is_before(Element_t x, Element_t y) const override;
+    Order_key_t order_key(Element_t x) const override;
 
     size_t total_elements_capacity() override;
     void extend_elements_capacity() override;
     Element_t first_element() override;
+    std::optional<Element_t> next_element(Element_t x) override;
 };
 
 class DynamicOrderList : public DynamicOrder {
    private:
     using Label_t = size_t;
+    // Position of a node in `upper_nodes` or `lower_nodes`.
+    using Node_id_t = size_t;
     constexpr static Label_t LOG_MAX = 62;
     constexpr static Label_t MAX_LABEL = 1LL << LOG_MAX;
+    constexpr static Label_t MIN_STEP_SIZE = MAX_LABEL / (LOG_MAX + 1);
+    constexpr static Node_id_t NO_NODE = std::numeric_limits<Node_id_t>::max();
+    // Sentinels of both lists. Element x is kept in `lower_nodes` at position
+    // x + ELEMENTS_OFFSET.
+    constexpr static Node_id_t HEAD = 0, TAIL = 1, ELEMENTS_OFFSET = 2;
 
     static size_t ceil(size_t x, size_t y) { return (x + y - 1) / y; }
 
-    struct UpperNode : std::enable_shared_from_this<UpperNode> {
+    // Nodes live in vectors and are linked by positions rather than allocated
+    // one by one, so relabeling a run of nodes touches few cache lines.
+    struct UpperNode {
         Label_t label;
-        std::shared_ptr<UpperNode> next;
-        std::weak_ptr<UpperNode> prev;
-
-        UpperNode(Label_t label, std::shared_ptr<UpperNode> next,
-                  const std::shared_ptr<UpperNode>& prev)
-            : label(label), next(std::move(next)), prev(prev) {}
-
-        std::shared_ptr<UpperNode> insert_after();
-        void remove();
-
-        int compare(const std::shared_ptr<UpperNode>& other) const;
+        Node_id_t next, prev;
     };
 
-    struct LowerNode : std::enable_shared_from_this<LowerNode> {
-        constexpr static Label_t MIN_STEP_SIZE = MAX_LABEL / (LOG_MAX + 1);
-
+    struct LowerNode {
         Label_t label;
-        std::shared_ptr<LowerNode> next;
-        std::weak_ptr<LowerNode> prev;
-        std::shared_ptr<UpperNode> parent;
-        Element_t value;
+        Node_id_t next, prev;
+        // NO_NODE iff the element is not in the list.
+        Node_id_t parent;
+    };
 
-        LowerNode(Label_t label, std::shared_ptr<LowerNode> next,
-                  const std::shared_ptr<LowerNode>& prev,
-                  const std::shared_ptr<UpperNode>& parent, Element_t value)
-            : label(label),
-              next(std::move(next)),
-              prev(prev),
-              parent(parent),
-              value(value) {}
+    std::vector<UpperNode> upper_nodes;
+    // Positions of removed upper nodes, reused by later insertions.
+    std::vector<Node_id_t> free_upper_nodes;
+    Huge_page_vector<LowerNode> lower_nodes;
 
-        std::shared_ptr<LowerNode> insert_after(Element_t next_value);
-        void remove() const;
+    Node_id_t insert_upper_after(Node_id_t node);
+    void remove_upper(Node_id_t node);
 
-        int compare(const std::shared_ptr<LowerNode>& other) const;
-    };
+    void insert_lower_after(Node_id_t node, Node_id_t new_node);
+    void remove_lower(Node_id_t node);
 
-    std::shared_ptr<LowerNode> head, tail;
-    std::vector<std::optional<std::shared_ptr<LowerNode>>> nodes;
+    int compare(Node_id_t x, Node_id_t y) const;
+    bool contains(Element_t x) const;
 
    public:
-    explicit DynamicOrderList(size_t no_elements) : nodes(no_elements) {
-        const auto upper_head =
-            std::make_shared<UpperNode>(0, nullptr, nullptr);
-        const auto upper_tail =
-            std::make_shared<UpperNode>(MAX_LABEL - 1, nullptr, upper_head);
-        upper_head->next = upper_tail;
-
-        head = std::make_shared<LowerNode>(0, nullptr, nullptr, upper_head, 0);
-        tail = std::make_shared<LowerNode>(MAX_LABEL - 1, nullptr, head,
-                                           upper_tail, 0);
-        head->next = tail;
+    explicit DynamicOrderList(size_t no_elements)
+        : upper_nodes{{0, TAIL, NO_NODE}, {MAX_LABEL - 1, NO_NODE, HEAD}},
+          lower_nodes(no_elements + ELEMENTS_OFFSET,
+                      {0, NO_NODE, NO_NODE, NO_NODE}) {
+        lower_nodes[HEAD] = {0, TAIL, NO_NODE, HEAD};
+        lower_nodes[TAIL] = {MAX_LABEL - 1, NO_NODE, HEAD, TAIL};
 
         for (size_t i = no_elements; i > 0; i--)
-            nodes[i - 1] = head->insert_after(i - 1);
-    }
-
-    ~DynamicOrderList() override {
-        auto curr_node = head;
-        while (curr_node) {
-            const auto next = curr_node->next;
-            curr_node->prev.reset();
-            curr_node->next = nullptr;
-            curr_node->parent = nullptr;
-            curr_node = next;
-        }
+            insert_lower_after(HEAD, i - 1 + ELEMENTS_OFFSET);
     }
 
     void insert_back(Element_t x) override;
@@ -240,10 +221,12 @@ class DynamicOrderList : public DynamicOrder {
     void remove(Element_t x) override;
 
     bool is_before(Element_t x, Element_t y) const override;
+    Order_key_t order_key(Element_t x) const override;
 
     size_t total_elements_capacity() override;
     void extend_elements_capacity() override;
     Element_t first_element() override;
+    std::optional<Element_t> next_element(Element_t x) override;
 };
 
 #endif  // DYNAMIC_ORDER_HPP
@@ -0,0 +1,66 @@
+#include "edge_filter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Set of edges packed into single numbers, stored in one array with linear
+// probing.
+class EdgeSet {
+   private:
+    static constexpr uint64_t EMPTY_SLOT = std::numeric_limits<uint64_t>::max();
+    // Fibonacci hashing, the top bits of the product select the slot.
+    static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    std::vector<uint64_t> slots;
+    int shift;
+
+   public:
+    // Keeps at least half of the slots empty for `no_elements` elements.
+    explicit EdgeSet(size_t no_elements) {
+        const auto no_slots =
+            std::bit_ceil(std::max<size_t>(no_elements, 1) * 2);
+        slots.assign(no_slots, EMPTY_SLOT);
+        shift = 64 - std::countr_zero(no_slots);
+    }
+
+    // Returns false if the element was already in the set.
+    bool insert(uint64_t element) {
+        const auto mask = slots.size() - 1;
+        for (auto slot = (element * HASH_MULTIPLIER) >> shift;;
+             slot = (slot + 1) & mask) {
+            if (slots[slot] == element)
+                return false;
+            if (slots[slot] == EMPTY_SLOT) {
+                slots[slot] = element;
+                return true;
+            }
+        }
+    }
+};
+
+}  // namespace
+
+DeduplicationStats deduplicate_edges(Raw_edges_list &edges,
+                                     size_t no_vertices) {
+    DeduplicationStats stats;
+    EdgeSet seen(edges.size());
+    size_t no_kept = 0;
+    for (const auto &[u, v] : edges) {
+        if (u == v) {
+            stats.no_self_loops++;
+            continue;
+        }
+        if (!seen.insert(static_cast<uint64_t>(u) * no_vertices + v)) {
+            stats.no_duplicates++;
+            continue;
+        }
+        edges[no_kept++] = {u, v};
+    }
+    edges.resize(no_kept);
+    return stats;
+}
@@ -0,0 +1,20 @@
+#ifndef EDGE_FILTER_HPP
+#define EDGE_FILTER_HPP
+
+#include <cstddef>
+
+#include "graph.hpp"
+
+// Numbers of edges removed by `deduplicate_edges`.
+struct DeduplicationStats {
+    size_t no_self_loops = 0;
+    size_t no_duplicates = 0;
+};
+
+// Removes self-loops and repeated edges, which don't change the components,
+// before they reach an algorithm. The first occurrence of every edge is kept
+// and the remaining edges stay in their order.
+DeduplicationStats deduplicate_edges(Raw_edges_list &edges,
+                                     size_t no_vertices);
+
+#endif  // EDGE_FILTER_HPP
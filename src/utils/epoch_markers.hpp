@@ -0,0 +1,89 @@
+#ifndef EPOCH_MARKERS_HPP
+#define EPOCH_MARKERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+// `NoFlags` sets of marked elements, each of which can be emptied in O(1).
+// Every flag has its own epoch and an element is marked if its stamp equals
+// the current epoch of the flag. Stamps of a single element are stored next
+// to each other, so checking several flags of one element touches a single
+// cache line.
+// Each element can also carry a `Payload`, which is stored in the same record
+// as its stamps. Algorithms keep there per-vertex data read together with
+// the markers during traversals.
+template <size_t NoFlags, typename Payload = std::monostate>
+class EpochMarkers {
+   private:
+    using Stamp_t = uint32_t;
+    using Stamps_t = std::array<Stamp_t, NoFlags>;
+
+    struct Record {
+        Stamps_t stamps{};
+        [[no_unique_address]] Payload payload{};
+    };
+
+    Stamps_t epochs;
+    Huge_page_vector<Record> records;
+
+   public:
+    explicit EpochMarkers(size_t no_elements = 0) : records(no_elements) {
+        epochs.fill(1);
+    }
+
+    size_t size() const { return records.size(); }
+    void resize(size_t no_elements) { records.resize(no_elements); }
+    void add_element(const Payload& payload = {}) {
+        records.push_back({{}, payload});
+    }
+
+    bool is_marked(size_t element, size_t flag = 0) const {
+        return records[element].stamps[flag] == epochs[flag];
+    }
+    void mark(size_t element, size_t flag = 0) {
+        records[element].stamps[flag] = epochs[flag];
+    }
+    void unmark(size_t element, size_t flag = 0) {
+        records[element].stamps[flag] = 0;
+    }
+
+    // Starts loading the record of the element ahead of its use.
+    void prefetch(size_t element) const {
+        __builtin_prefetch(&records[element]);
+    }
+
+    Payload& payload(size_t element) { return records[element].payload; }
+    const Payload& payload(size_t element) const {
+        return records[element].payload;
+    }
+
+    // Moves marks and the payload of element x to new_positions[x].
+    void permute(const std::vector<size_t>& new_positions) {
+        Huge_page_vector<Record> permuted(records.size());
+        for (size_t element = 0; element < records.size(); element++)
+            permuted[new_positions[element]] = records[element];
+        records = std::move(permuted);
+    }
+
+    // Unmarks all elements.
+    void next_epoch(size_t flag) {
+        if (++epochs[flag] != 0)
+            return;
+
+        // Stale stamps would become valid again after the wrap-around.
+        for (auto& record : records)
+            record.stamps[flag] = 0;
+        epochs[flag] = 1;
+    }
+    void next_epoch() {
+        for (size_t flag = 0; flag < NoFlags; flag++)
+            next_epoch(flag);
+    }
+};
+
+#endif  // EPOCH_MARKERS_HPP
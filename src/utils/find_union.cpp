@@ -7,6 +7,11 @@ FindUnion::FindUnion(size_t no_elements) {
         representants[i] = i;
 }
 
+void FindUnion::add_element() {
+    representants.push_back(representants.size());
+    group_sizes.push_back(1);
+}
+
 Vertex_id_t FindUnion::find_representant(Vertex_id_t u) const {
     while (representants[u] != u)
         u = representants[u];
@@ -27,3 +32,14 @@ std::optional<FindUnion::UnionResult> FindUnion::union_elements(Vertex_id_t u,
     group_sizes[u] += group_sizes[v];
     return FindUnion::UnionResult{u, v};
 }
+
+void FindUnion::renumber(const std::vector<Vertex_id_t>& new_ids) {
+    Huge_page_vector<Vertex_id_t> new_representants(representants.size());
+    Huge_page_vector<Group_size_t> new_group_sizes(group_sizes.size());
+    for (Vertex_id_t u = 0; u < representants.size(); u++) {
+        new_representants[new_ids[u]] = new_ids[find_representant(u)];
+        new_group_sizes[new_ids[u]] = group_sizes[u];
+    }
+    representants = std::move(new_representants);
+    group_sizes = std::move(new_group_sizes);
+}
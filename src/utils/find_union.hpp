@@ -5,13 +5,14 @@
 #include <vector>
 
 #include "graph.hpp"
+#include "huge_pages.hpp"
 
 using Group_size_t = size_t;
 
 class FindUnion {
    private:
-    std::vector<Vertex_id_t> representants;
-    std::vector<Group_size_t> group_sizes;
+    Huge_page_vector<Vertex_id_t> representants;
+    Huge_page_vector<Group_size_t> group_sizes;
 
    public:
     struct UnionResult {
@@ -22,8 +23,21 @@ class FindUnion {
     FindUnion() = default;
     explicit FindUnion(size_t no_elements);
 
+    // Appends a new element forming a singleton group.
+    void add_element();
+
     Vertex_id_t find_representant(Vertex_id_t u) const;
+    // Starts loading the parent of u ahead of `find_representant(u)`.
+    void prefetch(Vertex_id_t u) const {
+        __builtin_prefetch(&representants[u]);
+    }
+    // Whether u forms a group on its own.
+    bool is_singleton(Vertex_id_t u) const {
+        return representants[u] == u && group_sizes[u] == 1;
+    }
     std::optional<UnionResult> union_elements(Vertex_id_t u, Vertex_id_t v);
+    // Gives element u the id new_ids[u]. Paths get compressed on the way.
+    void renumber(const std::vector<Vertex_id_t> &new_ids);
 };
 
 #endif  // FIND_UNION_HPP
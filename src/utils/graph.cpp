@@ -1,49 +1,481 @@
 #include "graph.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+void write_varint(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t read_varint(const std::vector<uint8_t>& bytes, uint32_t& offset) {
+    uint64_t value = 0;
+    for (size_t shift = 0;; shift += 7) {
+        const auto byte = bytes[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+}
+
+}  // namespace
+
+EdgeStore::EdgeStore(std::vector<VertexPtr> initial_vertices) {
+    for (const auto& u : initial_vertices)
+        add_vertex(u);
+}
+
+Edge_id_t EdgeStore::allocate_record() {
+    if (!free_records.empty()) {
+        const auto edge = free_records.back();
+        free_records.pop_back();
+        return edge;
+    }
+    records.push_back(
+        {{}, {NO_EDGE, NO_EDGE}, {NO_EDGE, NO_EDGE}});
+    return static_cast<Edge_id_t>(records.size() - 1);
+}
+
+void EdgeStore::link_back(Vertex_id_t u, Edge_id_t edge,
+                          Direction direction) {
+    const auto sentinel = sentinels[u];
+    const auto last = records[sentinel].previous[direction];
+    records[edge].previous[direction] = last;
+    records[edge].next[direction] = sentinel;
+    records[last].next[direction] = edge;
+    records[sentinel].previous[direction] = edge;
+    no_neighbours[direction][u]++;
+}
+
+void EdgeStore::unlink(Edge_id_t edge, Direction direction) {
+    auto& record = records[edge];
+    records[record.previous[direction]].next[direction] =
+        record.next[direction];
+    records[record.next[direction]].previous[direction] =
+        record.previous[direction];
+    record.next[direction] = NO_EDGE;
+
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    if (record.next[opposite] == NO_EDGE)
+        free_records.push_back(edge);
+}
+
+void EdgeStore::unlink_reversed(Edge_id_t edge, Direction direction) {
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    const auto owner = records[edge].endpoints[direction];
+    unlink(edge, opposite);
+    // A list moved to another vertex leaves its old owner with no count.
+    if (no_neighbours[opposite][owner] > 0)
+        no_neighbours[opposite][owner]--;
+    if (compressed && no_records[opposite][owner] > 0)
+        no_records[opposite][owner]--;
+}
+
+void EdgeStore::add_vertex(const VertexPtr& u) {
+    const auto sentinel = allocate_record();
+    records[sentinel].endpoints = {0, 0};
+    records[sentinel].previous = {sentinel, sentinel};
+    records[sentinel].next = {sentinel, sentinel};
+    vertices.push_back(u);
+    sentinels.push_back(sentinel);
+    for (size_t direction = 0; direction < NO_DIRECTIONS; direction++) {
+        no_neighbours[direction].push_back(0);
+        no_moved_neighbours[direction].push_back(0);
+        no_records[direction].push_back(0);
+    }
+}
+
+void EdgeStore::add_edge(Vertex_id_t u, Vertex_id_t v, Direction direction,
+                         bool link_reversed) {
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    const auto edge = allocate_record();
+    records[edge].endpoints[direction] = v;
+    records[edge].endpoints[opposite] = u;
+    link_back(u, edge, direction);
+    if (link_reversed && bidirectional)
+        link_back(v, edge, opposite);
+
+    if (compressed) {
+        fold_if_needed(u, direction);
+        if (link_reversed && bidirectional)
+            fold_if_needed(v, opposite);
+    }
+}
+
+void EdgeStore::erase(Vertex_id_t u, const Position& position,
+                      Direction direction, bool erase_reversed) {
+    if (position.next_offset != 0) {
+        erase_compressed(u, position, direction);
+        return;
+    }
+
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    // Unlinking in the given direction may already free the record.
+    if (erase_reversed && records[position.edge].next[opposite] != NO_EDGE)
+        unlink_reversed(position.edge, direction);
+    unlink(position.edge, direction);
+    no_neighbours[direction][u]--;
+    if (compressed && no_records[direction][u] > 0)
+        no_records[direction][u]--;
+}
+
+void EdgeStore::clean_vertex(Vertex_id_t u, Direction direction) {
+    const auto sentinel = sentinels[u];
+    for (auto edge = records[sentinel].next[direction]; edge != sentinel;) {
+        const auto next_edge = records[edge].next[direction];
+        if (is_block(edge, direction))
+            release_block(edge, direction);
+        unlink(edge, direction);
+        edge = next_edge;
+    }
+    no_neighbours[direction][u] = 0;
+    no_moved_neighbours[direction][u] = 0;
+    no_records[direction][u] = 0;
+}
+
+void EdgeStore::move_neighbours(Vertex_id_t u, Vertex_id_t v,
+                                Direction direction) {
+    const auto u_sentinel = sentinels[u];
+    const auto v_sentinel = sentinels[v];
+    const auto first = records[u_sentinel].next[direction];
+    if (first == u_sentinel)
+        return;
+
+    const auto last = records[u_sentinel].previous[direction];
+    const auto v_last = records[v_sentinel].previous[direction];
+    records[v_last].next[direction] = first;
+    records[first].previous[direction] = v_last;
+    records[last].next[direction] = v_sentinel;
+    records[v_sentinel].previous[direction] = last;
+    records[u_sentinel].next[direction] = u_sentinel;
+    records[u_sentinel].previous[direction] = u_sentinel;
+
+    no_neighbours[direction][v] += no_neighbours[direction][u];
+    no_moved_neighbours[direction][v] += no_neighbours[direction][u];
+    no_records[direction][v] += no_records[direction][u];
+    no_neighbours[direction][u] = 0;
+    no_moved_neighbours[direction][u] = 0;
+    no_records[direction][u] = 0;
+}
+
+bool EdgeStore::should_compact(Vertex_id_t u, Direction direction) const {
+    return 2 * no_moved_neighbours[direction][u] >=
+               no_neighbours[direction][u] &&
+           no_moved_neighbours[direction][u] > 0;
+}
+
+void EdgeStore::mark_compacted(Vertex_id_t u, Direction direction) {
+    no_moved_neighbours[direction][u] = 0;
+    if (compressed) {
+        fold(u, direction, redirected);
+        redirected.clear();
+    }
+}
+
+void EdgeStore::redirect(const Position& position, Direction direction,
+                         Vertex_id_t v) {
+    if (position.next_offset == 0) {
+        records[position.edge].endpoints[direction] = v;
+    } else if (position.neighbour != v) {
+        // The block isn't released even if it gets empty, as the caller
+        // continues iterating over it.
+        auto& block = get_block(position.edge, direction);
+        block.bytes[position.offset] |= 1;
+        block.no_alive--;
+        redirected.push_back(v);
+    }
+}
+
+EdgeStore::Block& EdgeStore::get_block(Edge_id_t edge, Direction direction) {
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    return blocks[records[edge].endpoints[opposite]];
+}
+
+void EdgeStore::release_block(Edge_id_t edge, Direction direction) {
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    const auto block_index = records[edge].endpoints[opposite];
+    blocks[block_index] = Block();
+    free_blocks.push_back(block_index);
+}
+
+bool EdgeStore::enter_block(Position& position, Direction direction) const {
+    position.next_offset = 0;
+    position.neighbour = 0;
+    return advance_in_block(position, direction);
+}
+
+void EdgeStore::settle_in_blocks(Position& position,
+                                 Direction direction) const {
+    while (is_block(position.edge, direction)) {
+        if (enter_block(position, direction))
+            return;
+        position.edge = records[position.edge].next[direction];
+    }
+    settle(position, direction);
+}
+
+bool EdgeStore::advance_in_block(Position& position,
+                                 Direction direction) const {
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    const auto& bytes =
+        blocks[records[position.edge].endpoints[opposite]].bytes;
+    auto offset = position.next_offset;
+    auto neighbour = position.neighbour;
+    while (offset < bytes.size()) {
+        const auto entry_offset = offset;
+        const auto value = read_varint(bytes, offset);
+        neighbour += value >> 1;
+        if ((value & 1) == 0) {
+            position.offset = entry_offset;
+            position.next_offset = offset;
+            position.neighbour = neighbour;
+            return true;
+        }
+    }
+    return false;
+}
+
+void EdgeStore::erase_compressed(Vertex_id_t u, const Position& position,
+                                 Direction direction) {
+    auto& block = get_block(position.edge, direction);
+    block.bytes[position.offset] |= 1;
+    block.no_alive--;
+    no_neighbours[direction][u]--;
+    // Iterators can only point to alive entries, so none points to the block.
+    if (block.no_alive == 0) {
+        release_block(position.edge, direction);
+        unlink(position.edge, direction);
+    }
+}
+
+void EdgeStore::fold(Vertex_id_t u, Direction direction,
+                     const std::vector<Vertex_id_t>& extra_neighbours) {
+    folded.assign(extra_neighbours.begin(), extra_neighbours.end());
+    const auto sentinel = sentinels[u];
+    for (auto edge = records[sentinel].next[direction]; edge != sentinel;) {
+        const auto next_edge = records[edge].next[direction];
+        if (is_block(edge, direction)) {
+            Position position;
+            position.edge = edge;
+            for (auto found = enter_block(position, direction); found;
+                 found = advance_in_block(position, direction))
+                folded.push_back(position.neighbour);
+            release_block(edge, direction);
+        } else {
+            folded.push_back(records[edge].endpoints[direction]);
+        }
+        unlink(edge, direction);
+        edge = next_edge;
+    }
+
+    std::sort(folded.begin(), folded.end());
+    folded.erase(std::unique(folded.begin(), folded.end()), folded.end());
+    no_records[direction][u] = 0;
+    no_neighbours[direction][u] = folded.size();
+    if (folded.empty())
+        return;
+
+    size_t block_index;
+    if (free_blocks.empty()) {
+        block_index = blocks.size();
+        blocks.emplace_back();
+    } else {
+        block_index = free_blocks.back();
+        free_blocks.pop_back();
+    }
+    auto& block = blocks[block_index];
+    Vertex_id_t previous = 0;
+    for (const auto neighbour : folded) {
+        write_varint(block.bytes, (neighbour - previous) << 1);
+        previous = neighbour;
+    }
+    block.bytes.shrink_to_fit();
+    block.no_alive = folded.size();
+    folded.clear();
+
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    const auto edge = allocate_record();
+    records[edge].endpoints[direction] = BLOCK_RECORD;
+    records[edge].endpoints[opposite] = block_index;
+    link_back(u, edge, direction);
+    no_neighbours[direction][u]--;
+}
+
+void EdgeStore::fold_if_needed(Vertex_id_t u, Direction direction) {
+    const auto no_u_records = ++no_records[direction][u];
+    const auto no_u_neighbours = no_neighbours[direction][u];
+    const auto no_compressed =
+        no_u_neighbours > no_u_records ? no_u_neighbours - no_u_records : 0;
+    if (no_u_records >= std::max(MIN_FOLDED_RECORDS, no_compressed))
+        fold(u, direction);
+}
+
+void EdgeStore::reorder(const std::vector<Vertex_id_t>& order,
+                        Direction direction) {
+    std::vector<Edge_id_t> new_ids(records.size(), NO_EDGE);
+    Out_of_core_vector<Record> reordered;
+    reordered.reserve(records.size() - free_records.size());
+    const auto place = [&](Edge_id_t edge) {
+        if (new_ids[edge] != NO_EDGE)
+            return;
+        new_ids[edge] = static_cast<Edge_id_t>(reordered.size());
+        reordered.push_back(records[edge]);
+    };
+    const auto place_list = [&](Vertex_id_t u) {
+        const auto sentinel = sentinels[u];
+        if (new_ids[sentinel] != NO_EDGE)
+            return;
+        place(sentinel);
+        for (auto edge = records[sentinel].next[direction]; edge != sentinel;
+             edge = records[edge].next[direction])
+            place(edge);
+    };
+
+    for (const auto u : order)
+        place_list(u);
+    for (Vertex_id_t u = 0; u < vertices.size(); u++)
+        place_list(u);
+    // Records linked only into the opposite lists keep their relative order,
+    // found by a sequential scan rather than by walking the lists.
+    const auto opposite = direction == FORWARD ? BACKWARD : FORWARD;
+    for (Edge_id_t edge = 0; edge < records.size(); edge++) {
+        if (records[edge].next[opposite] != NO_EDGE)
+            place(edge);
+    }
+
+    for (auto& record : reordered) {
+        for (const auto list_direction : {FORWARD, BACKWARD}) {
+            if (record.next[list_direction] == NO_EDGE)
+                continue;
+            record.previous[list_direction] =
+                new_ids[record.previous[list_direction]];
+            record.next[list_direction] = new_ids[record.next[list_direction]];
+        }
+    }
+    for (auto& sentinel : sentinels)
+        sentinel = new_ids[sentinel];
+    records = std::move(reordered);
+    free_records.clear();
+}
+
+void EdgeStore::renumber(const std::vector<Vertex_id_t>& new_ids) {
+    if (compressed)
+        throw std::invalid_argument("A compressed store can't be renumbered");
+
+    const auto permute = [&](auto& values) {
+        auto permuted = values;
+        for (Vertex_id_t u = 0; u < vertices.size(); u++)
+            permuted[new_ids[u]] = values[u];
+        values = std::move(permuted);
+    };
+    for (Vertex_id_t u = 0; u < vertices.size(); u++)
+        vertices[u]->id = new_ids[u];
+    permute(vertices);
+    permute(sentinels);
+    for (const auto direction : {FORWARD, BACKWARD}) {
+        permute(no_neighbours[direction]);
+        permute(no_moved_neighbours[direction]);
+        permute(no_records[direction]);
+    }
+    // Without blocks every endpoint is a vertex, also in free records and
+    // sentinels, whose endpoints are never read.
+    for (auto& record : records) {
+        for (auto& endpoint : record.endpoints)
+            endpoint = new_ids[endpoint];
+    }
+}
+
 Graph::Graph(size_t no_vertices)
-    : no_vertices(no_vertices),
-      vertices(no_vertices),
-      adjacency_list(no_vertices) {
+    : store(std::make_shared<EdgeStore>(std::vector<VertexPtr>())) {
     for (size_t i = 0; i < no_vertices; i++)
-        vertices[i] = std::make_shared<Vertex>(i);
+        add_vertex();
+}
+
+void Graph::compress() { store->make_compressed(); }
+
+Graph Graph::reversed() {
+    store->make_bidirectional();
+    return {store, direction == FORWARD ? BACKWARD : FORWARD};
 }
 
-void Graph::add_edge(const VertexPtr& u, const VertexPtr& v) {
-    adjacency_list[u->id].push_back(v);
+VertexPtr Graph::add_vertex() {
+    const auto u = std::make_shared<Vertex>(store->get_no_vertices());
+    add_vertex(u);
+    return u;
 }
 
-void Graph::clean_vertex(const VertexPtr& u) { adjacency_list[u->id].clear(); }
+void Graph::add_vertex(const VertexPtr& u) { store->add_vertex(u); }
+
+void Graph::add_edge(const VertexPtr& u, const VertexPtr& v,
+                     bool link_reversed) {
+    store->add_edge(u->id, v->id, direction, link_reversed);
+}
+
+void Graph::add_edge_by_id(Vertex_id_t u, Vertex_id_t v, bool link_reversed) {
+    store->add_edge(u, v, direction, link_reversed);
+}
+
+void Graph::clean_vertex(const VertexPtr& u) {
+    store->clean_vertex(u->id, direction);
+}
+
+void Graph::clean_vertex_by_id(Vertex_id_t u) {
+    store->clean_vertex(u, direction);
+}
 
 void Graph::move_neighbours(const VertexPtr& u, const VertexPtr& v) {
-    adjacency_list[v->id].splice(adjacency_list[v->id].end(),
-                                 adjacency_list[u->id]);
+    store->move_neighbours(u->id, v->id, direction);
 }
 
 void Graph::move_neighbours_by_id(Vertex_id_t u, Vertex_id_t v) {
-    move_neighbours(get_vertex_by_id(u), get_vertex_by_id(v));
+    store->move_neighbours(u, v, direction);
+}
+
+bool Graph::should_compact(const VertexPtr& u) const {
+    return store->should_compact(u->id, direction);
+}
+
+void Graph::mark_compacted(const VertexPtr& u) {
+    store->mark_compacted(u->id, direction);
+}
+
+void Graph::reorder(const std::vector<Vertex_id_t>& order) {
+    store->reorder(order, direction);
+}
+
+void Graph::renumber(const std::vector<Vertex_id_t>& new_ids) {
+    store->renumber(new_ids);
 }
 
 size_t Graph::get_neighbours_no(const VertexPtr& u) const {
-    return adjacency_list[u->id].size();
+    return store->get_neighbours_no(u->id, direction);
 }
 
-Vertex_list::iterator Graph::get_neighbours_begin(const VertexPtr& u) {
-    return adjacency_list[u->id].begin();
+NeighbourList::iterator Graph::get_neighbours_begin(const VertexPtr& u) {
+    return get_neighbours(u).begin();
 }
 
-Vertex_list::iterator Graph::get_neighbours_end(const VertexPtr& u) {
-    return adjacency_list[u->id].end();
+NeighbourList::iterator Graph::get_neighbours_end(const VertexPtr& u) {
+    return get_neighbours(u).end();
 }
 
-std::list<VertexPtr>& Graph::get_neighbours(const VertexPtr& v) {
-    return adjacency_list[v->id];
+NeighbourList Graph::get_neighbours(const VertexPtr& v) {
+    return {store.get(), v->id, direction};
 }
 
 void Graph::erase_neighbour(const VertexPtr& u,
-                            Vertex_list::iterator neighbour_iter) {
-    adjacency_list[u->id].erase(neighbour_iter);
+                            NeighbourList::iterator neighbour_iter,
+                            bool erase_reversed) {
+    get_neighbours(u).erase(neighbour_iter, erase_reversed);
 }
 
-size_t Graph::get_no_vertices() const { return no_vertices; }
+size_t Graph::get_no_vertices() const { return store->get_no_vertices(); }
 
-VertexPtr Graph::get_vertex_by_id(Vertex_id_t id) { return vertices[id]; }
+VertexPtr Graph::get_vertex_by_id(Vertex_id_t id) {
+    return store->get_vertex_by_id(id);
+}
@@ -1,47 +1,361 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
-#include <list>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <vector>
 
+#include "huge_pages.hpp"
+#include "out_of_core.hpp"
 #include "vertex.hpp"
 
 using Raw_edge_t = std::pair<Vertex_id_t, Vertex_id_t>;
-using Raw_edges_list = std::vector<Raw_edge_t>;
-using Vertex_list = std::list<VertexPtr>;
+// The input stream, stored out of core like the adjacency lists.
+using Raw_edges_list = Out_of_core_vector<Raw_edge_t>;
+using Edge_id_t = uint32_t;
+
+enum Direction : size_t { FORWARD, BACKWARD, NO_DIRECTIONS };
+
+// Stores every edge as a single record, which can be threaded both into the
+// forward list of its source and into the backward list of its target.
+// Lists are circular and each vertex owns a sentinel record, so a record can
+// be unlinked from a list without knowing which vertex the list belongs to.
+// A record is reused once it isn't linked in any direction.
+// In the compressed mode, neighbours of a list are periodically folded into
+// a block of sorted, delta and varint encoded ids, which is linked into the
+// list in place of their records. New edges are appended as records.
+class EdgeStore {
+   public:
+    constexpr static Edge_id_t NO_EDGE = std::numeric_limits<Edge_id_t>::max();
+
+    // Position of a neighbour within a list. Within a block, `offset` is
+    // where the entry starts and `next_offset` where the next one does,
+    // otherwise both are 0.
+    struct Position {
+        Edge_id_t edge = NO_EDGE;
+        uint32_t offset = 0;
+        uint32_t next_offset = 0;
+        Vertex_id_t neighbour = 0;
+
+        bool operator==(const Position& other) const {
+            return edge == other.edge && offset == other.offset;
+        }
+    };
 
-class Graph {
    private:
-    size_t no_vertices = 0;
+    // Records of blocks have this endpoint in the direction of their list,
+    // the opposite endpoint is the index of the block.
+    constexpr static Vertex_id_t BLOCK_RECORD =
+        std::numeric_limits<Vertex_id_t>::max();
+    // Records are folded once there are at least that many of them and at
+    // least as many as compressed neighbours, so each neighbour gets
+    // re-encoded O(1) times on average.
+    constexpr static size_t MIN_FOLDED_RECORDS = 8;
+
+    // Aligned so that a record never spans two cache lines.
+    struct alignas(32) Record {
+        // Neighbour seen from the list of the given direction.
+        std::array<Vertex_id_t, NO_DIRECTIONS> endpoints;
+        std::array<Edge_id_t, NO_DIRECTIONS> previous;
+        // Equal to NO_EDGE if the record isn't linked in the direction.
+        std::array<Edge_id_t, NO_DIRECTIONS> next;
+    };
+
+    // Each entry is the difference to the previous one shifted left by one
+    // bit, the lowest bit marks erased entries.
+    struct Block {
+        std::vector<uint8_t> bytes;
+        size_t no_alive = 0;
+    };
+
     std::vector<VertexPtr> vertices;
-    std::vector<Vertex_list> adjacency_list;
+    // The bulk of the memory, may be stored out of core.
+    Out_of_core_vector<Record> records;
+    std::vector<Edge_id_t> free_records;
+    Huge_page_vector<Edge_id_t> sentinels;
+    // Edges erased through the other direction are subtracted from the count
+    // of their endpoint. If the list was moved since, its new owner isn't
+    // known, so these are only upper bounds.
+    std::array<std::vector<size_t>, NO_DIRECTIONS> no_neighbours;
+    // Number of neighbours moved to the list from other vertices since the
+    // list was last compacted.
+    std::array<std::vector<size_t>, NO_DIRECTIONS> no_moved_neighbours;
+    // Set once a backward view is created. Until then edges are linked only
+    // into forward lists.
+    bool bidirectional = false;
+
+    bool compressed = false;
+    std::vector<Block> blocks;
+    std::vector<size_t> free_blocks;
+    // Number of records in the list, i.e. neighbours which aren't compressed.
+    std::array<std::vector<size_t>, NO_DIRECTIONS> no_records;
+    // Neighbours of compressed entries redirected since the last compaction,
+    // passed to `fold` of the list by `mark_compacted`.
+    std::vector<Vertex_id_t> redirected;
+    std::vector<Vertex_id_t> folded;
+
+    Edge_id_t allocate_record();
+    void link_back(Vertex_id_t u, Edge_id_t edge, Direction direction);
+    // Frees the record if it's no longer linked in any direction.
+    void unlink(Edge_id_t edge, Direction direction);
+    // Unlinks the record from the opposite list, which is owned by its
+    // endpoint in `direction` unless the list was moved since, and updates
+    // the counts of the owner.
+    void unlink_reversed(Edge_id_t edge, Direction direction);
+
+    bool is_block(Edge_id_t edge, Direction direction) const {
+        return records[edge].endpoints[direction] == BLOCK_RECORD;
+    }
+    Block& get_block(Edge_id_t edge, Direction direction);
+    void release_block(Edge_id_t edge, Direction direction);
+    // Moves to the first alive entry of the block at `position.edge`.
+    bool enter_block(Position& position, Direction direction) const;
+    bool advance_in_block(Position& position, Direction direction) const;
+    void settle_in_blocks(Position& position, Direction direction) const;
+    void erase_compressed(Vertex_id_t u, const Position& position,
+                          Direction direction);
+    // Rewrites the whole list of u, together with `extra_neighbours`, into
+    // a single block of distinct neighbours.
+    void fold(Vertex_id_t u, Direction direction,
+              const std::vector<Vertex_id_t>& extra_neighbours = {});
+    void fold_if_needed(Vertex_id_t u, Direction direction);
+
+   public:
+    explicit EdgeStore(std::vector<VertexPtr> vertices);
+
+    void add_vertex(const VertexPtr& u);
+    const std::vector<VertexPtr>& get_vertices() const { return vertices; }
+    size_t get_no_vertices() const { return vertices.size(); }
+    const VertexPtr& get_vertex_by_id(Vertex_id_t id) const {
+        return vertices[id];
+    }
+
+    void make_bidirectional() { bidirectional = true; }
+    void make_compressed() { compressed = true; }
+    // Adds v to the list of u, and u to the list of v in the opposite
+    // direction if `link_reversed` is set and the store is bidirectional.
+    void add_edge(Vertex_id_t u, Vertex_id_t v, Direction direction,
+                  bool link_reversed);
+    // Erases the neighbour from the list of u. Also drops it from the
+    // opposite direction if `erase_reversed` is set, unless it's compressed.
+    void erase(Vertex_id_t u, const Position& position, Direction direction,
+               bool erase_reversed);
+    void clean_vertex(Vertex_id_t u, Direction direction);
+    void move_neighbours(Vertex_id_t u, Vertex_id_t v, Direction direction);
+
+    bool should_compact(Vertex_id_t u, Direction direction) const;
+    void mark_compacted(Vertex_id_t u, Direction direction);
+    size_t get_neighbours_no(Vertex_id_t u, Direction direction) const {
+        return no_neighbours[direction][u];
+    }
+    // Renumbers records so that lists of `direction` lie one after another,
+    // in `order` followed by the remaining vertices. Invalidates positions.
+    void reorder(const std::vector<Vertex_id_t>& order, Direction direction);
+    // Gives vertex u the id new_ids[u], also within lists. Blocks aren't
+    // rewritten, so the store can't be compressed.
+    void renumber(const std::vector<Vertex_id_t>& new_ids);
+
+    Position first(Vertex_id_t u, Direction direction) const {
+        Position position;
+        position.edge = records[sentinels[u]].next[direction];
+        settle(position, direction);
+        return position;
+    }
+    Position last(Vertex_id_t u) const {
+        Position position;
+        position.edge = sentinels[u];
+        return position;
+    }
+    // Moves to the first alive neighbour starting at `position.edge`.
+    void settle(Position& position, Direction direction) const {
+        const auto neighbour = records[position.edge].endpoints[direction];
+        if (neighbour == BLOCK_RECORD) [[unlikely]] {
+            settle_in_blocks(position, direction);
+            return;
+        }
+        position.offset = position.next_offset = 0;
+        position.neighbour = neighbour;
+    }
+    void advance(Position& position, Direction direction) const {
+        if (position.next_offset != 0) [[unlikely]] {
+            if (advance_in_block(position, direction))
+                return;
+            position.offset = position.next_offset = 0;
+        }
+        position.edge = records[position.edge].next[direction];
+        const auto neighbour = records[position.edge].endpoints[direction];
+        if (neighbour == BLOCK_RECORD) [[unlikely]] {
+            settle_in_blocks(position, direction);
+            return;
+        }
+        position.neighbour = neighbour;
+    }
+    // Neighbour stored in the record following `position`, read without
+    // settling on it. Only a hint: it's meaningless for blocks and sentinels.
+    // Also starts loading the record after it, so that walking the list
+    // stays a step ahead.
+    Vertex_id_t peek_next(const Position& position,
+                          Direction direction) const {
+        const auto& next = records[records[position.edge].next[direction]];
+        __builtin_prefetch(&records[next.next[direction]]);
+        return next.endpoints[direction];
+    }
+    // Compressed entries can't be rewritten in place. They are erased and
+    // their new neighbours are added by `mark_compacted`.
+    void redirect(const Position& position, Direction direction,
+                  Vertex_id_t v);
+};
+
+// List of neighbours of a single vertex in a single direction. Iterators stay
+// valid until their edge is erased, also when the list is moved to another
+// vertex.
+class NeighbourList {
+   public:
+    class iterator {
+       private:
+        EdgeStore* store = nullptr;
+        EdgeStore::Position position;
+        Direction direction = FORWARD;
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = VertexPtr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const VertexPtr*;
+        using reference = const VertexPtr&;
+
+        iterator() = default;
+        iterator(EdgeStore* store, EdgeStore::Position position,
+                 Direction direction)
+            : store(store), position(position), direction(direction) {}
+
+        const EdgeStore::Position& get_position() const { return position; }
+        // Id of the neighbour, doesn't touch the vertex object.
+        Vertex_id_t id() const { return position.neighbour; }
+        // Likely id of the next neighbour, see EdgeStore::peek_next.
+        Vertex_id_t peek_next_id() const {
+            return store->peek_next(position, direction);
+        }
+
+        reference operator*() const {
+            return store->get_vertex_by_id(position.neighbour);
+        }
+        pointer operator->() const { return &**this; }
+        iterator& operator++() {
+            store->advance(position, direction);
+            return *this;
+        }
+        iterator operator++(int) {
+            const auto previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const iterator& other) const {
+            return position == other.position;
+        }
+    };
+
+   private:
+    EdgeStore* store;
+    Vertex_id_t owner;
+    Direction direction;
+
+   public:
+    NeighbourList(EdgeStore* store, Vertex_id_t owner, Direction direction)
+        : store(store), owner(owner), direction(direction) {}
+
+    iterator begin() const {
+        return {store, store->first(owner, direction), direction};
+    }
+    iterator end() const { return {store, store->last(owner), direction}; }
+
+    // Returns the iterator following the erased one.
+    iterator erase(iterator neighbour_iter, bool erase_reversed = false) {
+        const auto next = std::next(neighbour_iter);
+        store->erase(owner, neighbour_iter.get_position(), direction,
+                     erase_reversed);
+        return next;
+    }
+    // Makes the edge point to v, e.g. the representative of its neighbour.
+    void redirect(iterator neighbour_iter, const VertexPtr& v) {
+        store->redirect(neighbour_iter.get_position(), direction, v->id);
+    }
+};
+
+// View of an EdgeStore in a single direction. Views created by `reversed`
+// share edges with the original graph.
+class Graph {
+   private:
+    std::shared_ptr<EdgeStore> store;
+    Direction direction = FORWARD;
+
+    Graph(std::shared_ptr<EdgeStore> store, Direction direction)
+        : store(std::move(store)), direction(direction) {}
 
    public:
-    Graph() = default;
+    Graph() : Graph(0) {}
     explicit Graph(size_t no_vertices);
     // Copies the vertex set of the other graph, doesn't add any edges.
     Graph(const Graph& other)
-        : no_vertices(other.no_vertices),
-          vertices(other.vertices),
-          adjacency_list(other.no_vertices) {}
+        : store(std::make_shared<EdgeStore>(other.store->get_vertices())) {}
+    Graph& operator=(const Graph&) = delete;
+
+    // Returns the graph with all edges reversed, sharing edges and vertices
+    // with this one. From now on, edges added to either of them are added to
+    // both.
+    Graph reversed();
+    // Switches the graph and its reversed views to the compressed mode of
+    // EdgeStore. Has to be called before any edge is added.
+    void compress();
+
+    // Appends a new isolated vertex with the next free id and returns it.
+    VertexPtr add_vertex();
+    // Appends a vertex created by another graph with the same vertex set.
+    void add_vertex(const VertexPtr& u);
 
-    void add_edge(const VertexPtr& u, const VertexPtr& v);
+    // Unless `link_reversed` is unset, the edge is also visible in the
+    // reversed graph.
+    void add_edge(const VertexPtr& u, const VertexPtr& v,
+                  bool link_reversed = true);
+    void add_edge_by_id(Vertex_id_t u, Vertex_id_t v,
+                        bool link_reversed = true);
 
     // Set the list of neighbours of u to an empty list.
     void clean_vertex(const VertexPtr& u);
+    void clean_vertex_by_id(Vertex_id_t u);
 
     // Moves all neighbours of u to the end of adjacency list of v.
     // When the function finishes u won't have any neighbours.
     void move_neighbours(const VertexPtr& u, const VertexPtr& v);
     void move_neighbours_by_id(Vertex_id_t u, Vertex_id_t v);
 
+    // Neighbours moved from merged vertices may point inside the merged
+    // component or duplicate each other. Returns if they make up at least
+    // half of the list of u, so that the merges pay for rewriting it.
+    bool should_compact(const VertexPtr& u) const;
+    void mark_compacted(const VertexPtr& u);
+
+    // Lays out the adjacency lists in memory in the given order of
+    // vertices, see EdgeStore::reorder. Invalidates all iterators.
+    void reorder(const std::vector<Vertex_id_t>& order);
+    // Renumbers vertices of the graph and its reversed views, see
+    // EdgeStore::renumber. Vertex objects are updated in place.
+    void renumber(const std::vector<Vertex_id_t>& new_ids);
+
     size_t get_neighbours_no(const VertexPtr& u) const;
-    Vertex_list::iterator get_neighbours_begin(const VertexPtr& u);
-    Vertex_list::iterator get_neighbours_end(const VertexPtr& u);
-    std::list<VertexPtr>& get_neighbours(const VertexPtr& v);
+    NeighbourList::iterator get_neighbours_begin(const VertexPtr& u);
+    NeighbourList::iterator get_neighbours_end(const VertexPtr& u);
+    NeighbourList get_neighbours(const VertexPtr& v);
 
+    // Erasing a loop from both directions is always safe, erasing
+    // a duplicated edge is not, as the reversed graph may keep only this copy.
     void erase_neighbour(const VertexPtr& u,
-                         Vertex_list::iterator neighbour_iter);
+                         NeighbourList::iterator neighbour_iter,
+                         bool erase_reversed = false);
 
     size_t get_no_vertices() const;
     VertexPtr get_vertex_by_id(Vertex_id_t id);
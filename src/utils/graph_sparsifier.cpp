@@ -17,9 +17,10 @@ void GraphSparsifier::insert_generated_edge(Vertex_id_t u,
 Vertex_id_t GraphSparsifier::generate_edge_to_unused(Vertex_id_t u_id) {
     const auto v_id = first_unused_vertex_no;
     first_unused_vertex_no++;
-    update_with_new_edge(u_id, v_id);
-    corresponding_graph_ids[v_id] = *global_first_unused_vertex_no;
+    corresponding_graph_ids.push_back(*global_first_unused_vertex_no);
     (*global_first_unused_vertex_no)++;
+    add_unused_vertex();
+    update_with_new_edge(u_id, v_id);
     add_generated_edge(u_id, v_id);
     return v_id;
 }
@@ -35,9 +36,7 @@ void SimpleGraphSparsifier::generate_new_edges(const VertexPtr& u) {
     degrees[representants[u->id]]++;
 }
 
-size_t SimpleGraphSparsifier::get_updated_no_of_vertices(size_t no_vertices) {
-    return 2 * no_vertices * NODE_NO_MULTIPLIER;
-}
+void SimpleGraphSparsifier::add_unused_vertex() { degrees.emplace_back(); }
 
 void SimpleGraphSparsifier::increase_edges_no() {
     (*no_edges)++;
@@ -62,6 +61,12 @@ void AdvancedGraphSparsifier::init(size_t original_no_vertices) {
         parents[id] = id;
 }
 
+void AdvancedGraphSparsifier::add_unused_vertex() {
+    parents.emplace_back();
+    depths.emplace_back();
+    degrees.emplace_back();
+}
+
 void AdvancedGraphSparsifier::update_with_new_edge(Vertex_id_t u_id,
                                                    Vertex_id_t v_id) {
     parents[v_id] = u_id;
@@ -90,10 +95,6 @@ void AdvancedGraphSparsifier::generate_new_edges(const VertexPtr& u) {
     degrees[w_id]++;
 }
 
-size_t AdvancedGraphSparsifier::get_updated_no_of_vertices(size_t no_vertices) {
-    return 2 * no_vertices * NODE_NO_MULTIPLIER;
-}
-
 void AdvancedGraphSparsifierForward::add_generated_edge(Vertex_id_t u,
                                                         Vertex_id_t v) {
     generated_edges->emplace_back(corresponding_graph_ids[u],
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "graph.hpp"
+#include "huge_pages.hpp"
 
 // Assume we have a graph G with average degree of a node equal to d.
 // It is possible to create a graph G* based on G, where reachability is
@@ -18,40 +19,42 @@ class GraphSparsifier {
     size_t first_unused_vertex_no;
     std::shared_ptr<size_t> global_first_unused_vertex_no;
 
-    std::vector<Vertex_id_t> representants;
-    std::vector<size_t> corresponding_graph_ids;
+    Huge_page_vector<Vertex_id_t> representants;
+    Huge_page_vector<size_t> corresponding_graph_ids;
 
     std::shared_ptr<std::vector<Raw_edge_t>> generated_edges;
 
     virtual void init(size_t original_no_vertices);
 
     virtual void add_generated_edge(Vertex_id_t u, Vertex_id_t v) = 0;
+    // Extends per-vertex data with a newly created vertex.
+    virtual void add_unused_vertex() {}
     virtual void update_with_new_edge(Vertex_id_t, Vertex_id_t) {}
     Vertex_id_t generate_edge_to_unused(Vertex_id_t u_id);
 
    public:
-    // Since in G* we create some new vertices, we want to initialize the object
-    // with sufficient number of elements.
-    GraphSparsifier(size_t original_no_vertices, size_t node_no_multiplier)
+    // Vertices of G* are created on demand, so the per-vertex data initially
+    // covers only the vertices of G.
+    explicit GraphSparsifier(size_t original_no_vertices)
         : no_edges(std::make_shared<size_t>(0)),
           first_unused_vertex_no(original_no_vertices),
           global_first_unused_vertex_no(
               std::make_shared<size_t>(original_no_vertices)),
           representants(original_no_vertices),
-          corresponding_graph_ids(original_no_vertices * node_no_multiplier),
+          corresponding_graph_ids(original_no_vertices),
           generated_edges(std::make_shared<std::vector<Raw_edge_t>>()) {
         GraphSparsifier::init(original_no_vertices);
     }
-    GraphSparsifier(size_t original_no_vertices, size_t node_no_multiplier,
-                    const GraphSparsifier& other)
+    GraphSparsifier(size_t original_no_vertices, const GraphSparsifier& other)
         : no_edges(other.no_edges),
           first_unused_vertex_no(original_no_vertices),
           global_first_unused_vertex_no(other.global_first_unused_vertex_no),
           representants(original_no_vertices),
-          corresponding_graph_ids(original_no_vertices * node_no_multiplier),
+          corresponding_graph_ids(original_no_vertices),
           generated_edges(other.generated_edges) {
         GraphSparsifier::init(original_no_vertices);
     }
+    GraphSparsifier(GraphSparsifier&&) = default;
     virtual ~GraphSparsifier() = default;
 
     const std::shared_ptr<std::vector<Raw_edge_t>>& get_generated_edges()
@@ -65,33 +68,37 @@ class GraphSparsifier {
 
     Vertex_id_t get_corresponding_id(const VertexPtr& u) const;
     virtual void increase_edges_no() {}
+
+    // Returns the number of vertices of G* created so far, shared by the
+    // forward and backward sparsifiers.
+    size_t get_no_vertices() const { return *global_first_unused_vertex_no; }
 };
 
 class SimpleGraphSparsifier : public GraphSparsifier {
    protected:
-    constexpr static size_t NODE_NO_MULTIPLIER = 4;
     constexpr static size_t MIN_AVERAGE_DEGREE = 10;
     size_t original_no_vertices;
     std::shared_ptr<size_t> average_degree;
 
-    std::vector<size_t> degrees;
+    Huge_page_vector<size_t> degrees;
+
+    void add_unused_vertex() override;
 
    public:
     explicit SimpleGraphSparsifier(size_t original_no_vertices)
-        : GraphSparsifier(original_no_vertices, NODE_NO_MULTIPLIER),
+        : GraphSparsifier(original_no_vertices),
           original_no_vertices(original_no_vertices),
           average_degree(std::make_shared<size_t>(MIN_AVERAGE_DEGREE)),
-          degrees(original_no_vertices * NODE_NO_MULTIPLIER) {}
+          degrees(original_no_vertices) {}
     SimpleGraphSparsifier(size_t original_no_vertices,
                           const SimpleGraphSparsifier& other)
-        : GraphSparsifier(original_no_vertices, NODE_NO_MULTIPLIER, other),
+        : GraphSparsifier(original_no_vertices, other),
           original_no_vertices(original_no_vertices),
           average_degree(other.average_degree),
-          degrees(original_no_vertices * NODE_NO_MULTIPLIER) {}
+          degrees(original_no_vertices) {}
 
     void generate_new_edges(const VertexPtr& u) override;
 
-    static size_t get_updated_no_of_vertices(size_t no_vertices);
     void increase_edges_no() override;
 };
 
@@ -119,50 +126,45 @@ class SimpleGraphSparsifierBackward : public SimpleGraphSparsifier {
 // Expected Total Time"
 class AdvancedGraphSparsifier : public GraphSparsifier {
    protected:
-    constexpr static size_t NODE_NO_MULTIPLIER = 8;
     constexpr static size_t INITIAL_LAYERS_NO = 1;
     constexpr static size_t MIN_AVERAGE_DEGREE = 2;
-    size_t no_vertices;
     size_t average_degree;
 
     // Represents a balanced "tree" from the sparsification process description.
     // We represent the tree structure purely by ids, not actual vertices.
-    std::vector<size_t> layers_no;
-    std::vector<Vertex_id_t> parents;
-    std::vector<size_t> depths;
-    std::vector<size_t> degrees;
+    Huge_page_vector<size_t> layers_no;
+    Huge_page_vector<Vertex_id_t> parents;
+    Huge_page_vector<size_t> depths;
+    Huge_page_vector<size_t> degrees;
 
     void init(size_t original_no_vertices) override;
 
+    void add_unused_vertex() override;
     void update_with_new_edge(Vertex_id_t u_id, Vertex_id_t v_id) override;
 
    public:
     AdvancedGraphSparsifier(size_t original_no_vertices, size_t no_edges)
-        : GraphSparsifier(original_no_vertices, NODE_NO_MULTIPLIER),
-          no_vertices(original_no_vertices * NODE_NO_MULTIPLIER),
+        : GraphSparsifier(original_no_vertices),
           average_degree(std::max(MIN_AVERAGE_DEGREE,
                                   ceil(no_edges, original_no_vertices))),
           layers_no(original_no_vertices, INITIAL_LAYERS_NO),
-          parents(no_vertices),
-          depths(no_vertices),
-          degrees(no_vertices) {
+          parents(original_no_vertices),
+          depths(original_no_vertices),
+          degrees(original_no_vertices) {
         AdvancedGraphSparsifier::init(original_no_vertices);
     }
     AdvancedGraphSparsifier(size_t original_no_vertices,
                             const AdvancedGraphSparsifier& other)
-        : GraphSparsifier(original_no_vertices, NODE_NO_MULTIPLIER, other),
-          no_vertices(other.no_vertices),
+        : GraphSparsifier(original_no_vertices, other),
           average_degree(other.average_degree),
           layers_no(original_no_vertices, INITIAL_LAYERS_NO),
-          parents(no_vertices),
-          depths(no_vertices),
-          degrees(no_vertices) {
+          parents(original_no_vertices),
+          depths(original_no_vertices),
+          degrees(original_no_vertices) {
         AdvancedGraphSparsifier::init(original_no_vertices);
     }
 
     void generate_new_edges(const VertexPtr& u) override;
-
-    static size_t get_updated_no_of_vertices(size_t no_vertices);
 };
 
 class AdvancedGraphSparsifierForward : public AdvancedGraphSparsifier {
@@ -0,0 +1,71 @@
+#include "huge_pages.hpp"
+
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+bool huge_pages_enabled = false;
+
+size_t round_to_huge_pages(size_t bytes) {
+    return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+#ifdef __linux__
+void *map_aligned(size_t bytes) {
+    if (huge_pages_enabled) {
+        void *pointer = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pointer != MAP_FAILED)
+            return pointer;
+    }
+
+    // Transparent huge pages are only used for aligned ranges, so the mapping
+    // is trimmed to a multiple of the huge page size.
+    const auto padded_bytes = bytes + HUGE_PAGE_SIZE;
+    void *mapping = mmap(nullptr, padded_bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    const auto begin = reinterpret_cast<uintptr_t>(mapping);
+    const auto aligned = round_to_huge_pages(begin);
+    if (aligned != begin)
+        munmap(mapping, aligned - begin);
+    if (aligned + bytes != begin + padded_bytes)
+        munmap(reinterpret_cast<void *>(aligned + bytes),
+               begin + padded_bytes - aligned - bytes);
+
+    auto *pointer = reinterpret_cast<void *>(aligned);
+    // Without THP support the advice is rejected and regular pages are used.
+    if (huge_pages_enabled)
+        madvise(pointer, bytes, MADV_HUGEPAGE);
+    return pointer;
+}
+#endif
+
+}  // namespace
+
+void enable_huge_pages() { huge_pages_enabled = true; }
+
+void *allocate_pages(size_t bytes) {
+#ifdef __linux__
+    if (bytes >= HUGE_PAGE_SIZE)
+        return map_aligned(round_to_huge_pages(bytes));
+#endif
+    return ::operator new(bytes);
+}
+
+void deallocate_pages(void *pointer, size_t bytes) {
+#ifdef __linux__
+    if (bytes >= HUGE_PAGE_SIZE) {
+        munmap(pointer, round_to_huge_pages(bytes));
+        return;
+    }
+#endif
+    ::operator delete(pointer);
+}
@@ -0,0 +1,46 @@
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Allocations of at least HUGE_PAGE_SIZE bytes are mapped directly and
+// aligned to huge pages, smaller ones go through operator new. Once huge
+// pages are enabled, large allocations are backed by reserved huge pages
+// (MAP_HUGETLB) if there are any, and by transparent huge pages otherwise.
+// Without huge pages, or on other systems than Linux, they fall back to
+// regular pages.
+constexpr size_t HUGE_PAGE_SIZE = size_t{1} << 21;
+
+// Affects only allocations made afterwards.
+void enable_huge_pages();
+
+void *allocate_pages(size_t bytes);
+void deallocate_pages(void *pointer, size_t bytes);
+
+// Allocator for large per-vertex and adjacency arrays.
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(allocate_pages(n * sizeof(T)));
+    }
+    void deallocate(T *pointer, size_t n) {
+        deallocate_pages(pointer, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U> &) const {
+        return true;
+    }
+};
+
+template <typename T>
+using Huge_page_vector = std::vector<T, HugePageAllocator<T>>;
+
+#endif  // HUGE_PAGES_HPP
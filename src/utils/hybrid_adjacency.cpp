@@ -0,0 +1,89 @@
+#include "hybrid_adjacency.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+HybridAdjacency::HybridAdjacency(size_t no_vertices)
+    : no_vertices(no_vertices),
+      // A bitset row takes `bitset_no_words(n)` words, as many as a vector of
+      // that many neighbours.
+      dense_threshold(bitset_no_words(no_vertices)),
+      rows(no_vertices) {}
+
+void HybridAdjacency::promote(Row& row) const {
+    row.dense = std::make_unique<Bitset>(no_vertices);
+    for (const auto v : row.sparse)
+        row.dense->set(v);
+    std::vector<Vertex_id_t>().swap(row.sparse);
+}
+
+bool HybridAdjacency::contains(Vertex_id_t u, Vertex_id_t v) const {
+    const auto& row = rows[u];
+    if (row.dense)
+        return row.dense->get(v);
+    return std::binary_search(row.sparse.begin(), row.sparse.end(), v);
+}
+
+void HybridAdjacency::insert(Vertex_id_t u, Vertex_id_t v) {
+    auto& row = rows[u];
+    if (row.dense) {
+        row.dense->set(v);
+        return;
+    }
+
+    const auto position =
+        std::lower_bound(row.sparse.begin(), row.sparse.end(), v);
+    if (position != row.sparse.end() && *position == v)
+        return;
+    row.sparse.insert(position, v);
+    if (row.sparse.size() > dense_threshold)
+        promote(row);
+}
+
+void HybridAdjacency::merge_rows(Vertex_id_t u, Vertex_id_t v) {
+    auto& target = rows[u];
+    const auto& source = rows[v];
+    if (source.dense && !target.dense)
+        promote(target);
+
+    if (target.dense) {
+        if (source.dense) {
+            bitset_or(target.dense->data(), source.dense->data(),
+                      target.dense->get_no_words());
+        } else {
+            for (const auto w : source.sparse)
+                target.dense->set(w);
+        }
+        return;
+    }
+
+    std::vector<Vertex_id_t> merged;
+    merged.reserve(target.sparse.size() + source.sparse.size());
+    std::set_union(target.sparse.begin(), target.sparse.end(),
+                   source.sparse.begin(), source.sparse.end(),
+                   std::back_inserter(merged));
+    target.sparse = std::move(merged);
+    if (target.sparse.size() > dense_threshold)
+        promote(target);
+}
+
+void HybridAdjacency::clear_row(Vertex_id_t u) {
+    auto& row = rows[u];
+    row.dense.reset();
+    std::vector<Vertex_id_t>().swap(row.sparse);
+}
+
+size_t HybridAdjacency::get_row_cost(Vertex_id_t u) const {
+    const auto& row = rows[u];
+    return row.dense ? row.dense->get_no_words() : row.sparse.size();
+}
+
+bool HybridAdjacency::row_intersects(Vertex_id_t u, const Bitset& mask) const {
+    const auto& row = rows[u];
+    if (row.dense) {
+        return bitset_intersects(row.dense->data(), mask.data(),
+                                 mask.get_no_words());
+    }
+    return std::any_of(row.sparse.begin(), row.sparse.end(),
+                       [&](Vertex_id_t v) { return mask.get(v); });
+}
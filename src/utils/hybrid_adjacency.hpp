@@ -0,0 +1,64 @@
+#ifndef HYBRID_ADJACENCY_HPP
+#define HYBRID_ADJACENCY_HPP
+
+#include <memory>
+#include <vector>
+
+#include "bitset.hpp"
+#include "vertex.hpp"
+
+// Adjacency rows supporting fast edge-existence checks. A row is kept as a
+// sorted vector of neighbours and gets promoted to a bitset once its degree
+// makes the bitset not larger than the vector. The total memory is therefore
+// O(n + m) words.
+class HybridAdjacency {
+   private:
+    struct Row {
+        std::vector<Vertex_id_t> sparse;
+        std::unique_ptr<Bitset> dense;
+    };
+
+    size_t no_vertices;
+    size_t dense_threshold;
+    std::vector<Row> rows;
+
+    void promote(Row& row) const;
+
+   public:
+    explicit HybridAdjacency(size_t no_vertices);
+
+    bool contains(Vertex_id_t u, Vertex_id_t v) const;
+    void insert(Vertex_id_t u, Vertex_id_t v);
+
+    // row(u) |= row(v)
+    void merge_rows(Vertex_id_t u, Vertex_id_t v);
+    void clear_row(Vertex_id_t u);
+
+    // Returns the number of steps needed by `row_intersects`.
+    size_t get_row_cost(Vertex_id_t u) const;
+    // Returns if any neighbour of u is marked in `mask`, which has to be able
+    // to store `no_vertices` bits.
+    bool row_intersects(Vertex_id_t u, const Bitset& mask) const;
+
+    // Calls `f` with every neighbour of u.
+    template <typename F>
+    void for_each_in_row(Vertex_id_t u, F&& f) const {
+        const auto& row = rows[u];
+        if (!row.dense) {
+            for (const auto v : row.sparse)
+                f(v);
+            return;
+        }
+        const auto* words = row.dense->data();
+        for (size_t word = 0; word < row.dense->get_no_words(); word++) {
+            auto bits = words[word];
+            while (bits) {
+                f(word * BITSET_WORD_BITS +
+                  static_cast<size_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+#endif  // HYBRID_ADJACENCY_HPP
@@ -0,0 +1,62 @@
+#ifndef ITERATIVE_DFS_HPP
+#define ITERATIVE_DFS_HPP
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Depth-first search driven by an explicit stack instead of recursion, so the
+// depth of the traversal isn't limited by the size of the call stack. The
+// stack is kept between traversals to avoid reallocations.
+// The traversal is described by callbacks:
+// - `enter(x)` is called when x is entered and returns the range of its edges
+//   as a pair of iterators,
+// - `visit_edge(x, iter)` processes the edge pointed by `iter`, advances
+//   `iter` (it may erase the edge or skip to the end) and returns the vertex
+//   to descend into, if any,
+// - `after_child(x, y)` is called when the traversal returns from y to x,
+// - `leave(x)` is called when all edges of x are processed (post-order).
+// Ranges of vertices on the stack mustn't be invalidated by the callbacks.
+template <typename Vertex_t, typename Iterator_t>
+class IterativeDfs {
+   private:
+    struct Frame {
+        Vertex_t vertex;
+        Iterator_t next;
+        Iterator_t end;
+    };
+
+    std::vector<Frame> stack;
+
+   public:
+    template <typename Enter, typename VisitEdge, typename AfterChild,
+              typename Leave>
+    void run(const Vertex_t& source, Enter&& enter, VisitEdge&& visit_edge,
+             AfterChild&& after_child, Leave&& leave) {
+        const auto push = [&](const Vertex_t& x) {
+            const auto [begin, end] = enter(x);
+            stack.push_back({x, begin, end});
+        };
+
+        push(source);
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            if (frame.next == frame.end) {
+                const auto finished = std::move(frame.vertex);
+                stack.pop_back();
+                leave(finished);
+                if (!stack.empty())
+                    after_child(stack.back().vertex, finished);
+                continue;
+            }
+
+            // Pushing the child invalidates `frame`.
+            const std::optional<Vertex_t> child =
+                visit_edge(frame.vertex, frame.next);
+            if (child.has_value())
+                push(*child);
+        }
+    }
+};
+
+#endif  // ITERATIVE_DFS_HPP
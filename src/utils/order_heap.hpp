@@ -0,0 +1,142 @@
+#ifndef ORDER_HEAP_HPP
+#define ORDER_HEAP_HPP
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "dynamic_order.hpp"
+
+// Indexed d-ary heap over elements of a DynamicOrder. Keys returned by
+// `DynamicOrder::order_key` are cached next to the elements, so heap
+// operations don't query the order. Once the order gets modified, all cached
+// keys are lazily recomputed before the next heap operation.
+// With `KeyCompare = std::less<>` the element that occurs first in the order
+// is at the top of the heap, with `std::greater<>` the last one.
+template <typename KeyCompare>
+class OrderHeap {
+   private:
+    constexpr static size_t ARITY = 4;
+    constexpr static size_t NOT_IN_HEAP = std::numeric_limits<size_t>::max();
+
+    struct Entry {
+        Order_key_t key;
+        Element_t element;
+    };
+
+    DynamicOrderPtr order;
+    size_t cached_version;
+    std::vector<Entry> entries;
+    // For each element stores its index within `entries`.
+    std::vector<size_t> positions;
+    KeyCompare compare;
+
+    void place(const Entry& entry, size_t index) {
+        entries[index] = entry;
+        positions[entry.element] = index;
+    }
+
+    void sift_up(size_t index) {
+        const auto entry = entries[index];
+        while (index > 0) {
+            const auto parent = (index - 1) / ARITY;
+            if (!compare(entry.key, entries[parent].key))
+                break;
+            place(entries[parent], index);
+            index = parent;
+        }
+        place(entry, index);
+    }
+
+    void sift_down(size_t index) {
+        const auto entry = entries[index];
+        while (true) {
+            const auto first_child = index * ARITY + 1;
+            if (first_child >= entries.size())
+                break;
+            const auto last_child =
+                std::min(first_child + ARITY, entries.size());
+            auto best_child = first_child;
+            for (auto child = first_child + 1; child < last_child; child++) {
+                if (compare(entries[child].key, entries[best_child].key))
+                    best_child = child;
+            }
+            if (!compare(entries[best_child].key, entry.key))
+                break;
+            place(entries[best_child], index);
+            index = best_child;
+        }
+        place(entry, index);
+    }
+
+    void refresh_keys() {
+        if (cached_version == order->get_version())
+            return;
+
+        cached_version = order->get_version();
+        for (auto& entry : entries)
+            entry.key = order->order_key(entry.element);
+        for (auto index = entries.size() / ARITY + 1; index > 0; index--) {
+            if (index - 1 < entries.size())
+                sift_down(index - 1);
+        }
+    }
+
+   public:
+    OrderHeap(size_t no_elements, DynamicOrderPtr order)
+        : order(std::move(order)),
+          cached_version(this->order->get_version()),
+          positions(no_elements, NOT_IN_HEAP) {}
+
+    // Makes room for the next element of the order.
+    void add_element() { positions.push_back(NOT_IN_HEAP); }
+
+    bool empty() const { return entries.empty(); }
+
+    bool contains(Element_t x) const { return positions[x] != NOT_IN_HEAP; }
+
+    // Does nothing if the element is already present in the heap.
+    void insert(Element_t x) {
+        if (contains(x))
+            return;
+        refresh_keys();
+        entries.push_back({order->order_key(x), x});
+        sift_up(entries.size() - 1);
+    }
+
+    // Does nothing if the element is not present in the heap.
+    void erase(Element_t x) {
+        if (!contains(x))
+            return;
+        refresh_keys();
+        const auto index = positions[x];
+        positions[x] = NOT_IN_HEAP;
+        const auto last = entries.back();
+        entries.pop_back();
+        if (index == entries.size())
+            return;
+
+        place(last, index);
+        if (index > 0 && compare(last.key, entries[(index - 1) / ARITY].key))
+            sift_up(index);
+        else
+            sift_down(index);
+    }
+
+    std::optional<Element_t> top() {
+        if (entries.empty())
+            return std::nullopt;
+        refresh_keys();
+        return entries.front().element;
+    }
+
+    void clear() {
+        for (const auto& entry : entries)
+            positions[entry.element] = NOT_IN_HEAP;
+        entries.clear();
+    }
+};
+
+#endif  // ORDER_HEAP_HPP
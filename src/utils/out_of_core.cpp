@@ -0,0 +1,60 @@
+#include "out_of_core.hpp"
+
+#include <new>
+#include <optional>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::optional<std::string> out_of_core_directory;
+
+#ifdef __linux__
+// Returns a descriptor of a new, already unlinked file of the given size.
+int create_backing_file(size_t bytes) {
+    auto path = *out_of_core_directory + "/incremental-scc-XXXXXX";
+    const auto fd = mkstemp(path.data());
+    if (fd == -1)
+        throw std::runtime_error("Cannot create a file in " +
+                                 *out_of_core_directory);
+    unlink(path.c_str());
+    if (ftruncate(fd, static_cast<off_t>(bytes)) == -1) {
+        close(fd);
+        throw std::bad_alloc();
+    }
+    return fd;
+}
+#endif
+
+}  // namespace
+
+void enable_out_of_core(const std::string &directory) {
+    out_of_core_directory = directory;
+#ifdef __linux__
+    close(create_backing_file(0));
+#endif
+}
+
+void *allocate_out_of_core(size_t bytes) {
+#ifdef __linux__
+    if (out_of_core_directory.has_value() && bytes >= HUGE_PAGE_SIZE) {
+        // Rounded like in `allocate_pages`, so that `deallocate_pages`
+        // unmaps the whole file.
+        const auto mapped_bytes =
+            (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        const auto fd = create_backing_file(mapped_bytes);
+        void *pointer = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+        // The mapping keeps the file alive.
+        close(fd);
+        if (pointer == MAP_FAILED)
+            throw std::bad_alloc();
+        return pointer;
+    }
+#endif
+    return allocate_pages(bytes);
+}
@@ -0,0 +1,47 @@
+#ifndef OUT_OF_CORE_HPP
+#define OUT_OF_CORE_HPP
+
+#include <string>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+// Once a directory is set, large adjacency arrays are stored in files
+// created there and mapped into memory. The kernel keeps recently used pages
+// cached and writes the cold ones back to the files, so the arrays can exceed
+// RAM. Files are removed right after they are created, so they don't outlive
+// the process. Without a directory, or on other systems than Linux, arrays
+// are allocated like with HugePageAllocator.
+
+// Affects only allocations made afterwards. Throws if the directory can't be
+// used.
+void enable_out_of_core(const std::string &directory);
+
+void *allocate_out_of_core(size_t bytes);
+
+template <typename T>
+struct OutOfCoreAllocator {
+    using value_type = T;
+
+    OutOfCoreAllocator() = default;
+    template <typename U>
+    OutOfCoreAllocator(const OutOfCoreAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(allocate_out_of_core(n * sizeof(T)));
+    }
+    // Mappings of files are released the same way as anonymous ones.
+    void deallocate(T *pointer, size_t n) {
+        deallocate_pages(pointer, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const OutOfCoreAllocator<U> &) const {
+        return true;
+    }
+};
+
+template <typename T>
+using Out_of_core_vector = std::vector<T, OutOfCoreAllocator<T>>;
+
+#endif  // OUT_OF_CORE_HPP
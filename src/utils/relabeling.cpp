@@ -0,0 +1,101 @@
+#include "relabeling.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+std::vector<size_t> get_degrees(const Raw_edges_list &edges,
+                                size_t no_vertices) {
+    std::vector<size_t> degrees(no_vertices, 0);
+    for (const auto &[u, v] : edges) {
+        degrees[u]++;
+        degrees[v]++;
+    }
+    return degrees;
+}
+
+// Vertices sorted by degree, ties broken by the id.
+std::vector<Vertex_id_t> sort_by_degree(const std::vector<size_t> &degrees,
+                                        bool decreasing) {
+    std::vector<Vertex_id_t> vertices(degrees.size());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::ranges::stable_sort(vertices, [&](Vertex_id_t u, Vertex_id_t v) {
+        return decreasing ? degrees[u] > degrees[v] : degrees[u] < degrees[v];
+    });
+    return vertices;
+}
+
+std::vector<Vertex_id_t> get_bfs_order(const Raw_edges_list &edges,
+                                       const std::vector<size_t> &degrees) {
+    const auto no_vertices = degrees.size();
+    // Undirected adjacency lists stored one after another.
+    std::vector<size_t> offsets(no_vertices + 1, 0);
+    std::partial_sum(degrees.begin(), degrees.end(), offsets.begin() + 1);
+    std::vector<Vertex_id_t> neighbours(offsets.back());
+    auto free_slots = offsets;
+    for (const auto &[u, v] : edges) {
+        neighbours[free_slots[u]++] = v;
+        neighbours[free_slots[v]++] = u;
+    }
+
+    std::vector<bool> visited(no_vertices, false);
+    std::vector<Vertex_id_t> order;
+    order.reserve(no_vertices);
+    for (const auto root : sort_by_degree(degrees, false)) {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        order.push_back(root);
+        // `order` doubles as the queue of the search.
+        for (auto head = order.size() - 1; head < order.size(); head++) {
+            const auto u = order[head];
+            for (auto i = offsets[u]; i < offsets[u + 1]; i++) {
+                if (!visited[neighbours[i]]) {
+                    visited[neighbours[i]] = true;
+                    order.push_back(neighbours[i]);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+}  // namespace
+
+std::optional<Relabeling> parse_relabeling(const std::string &name) {
+    if (name == "none")
+        return Relabeling::NONE;
+    if (name == "bfs")
+        return Relabeling::BFS;
+    if (name == "degree")
+        return Relabeling::DEGREE;
+    return std::nullopt;
+}
+
+std::vector<Vertex_id_t> compute_relabeling(const Raw_edges_list &edges,
+                                            size_t no_vertices,
+                                            Relabeling relabeling) {
+    std::vector<Vertex_id_t> order;
+    if (relabeling == Relabeling::NONE) {
+        order.resize(no_vertices);
+        std::iota(order.begin(), order.end(), 0);
+    } else {
+        const auto degrees = get_degrees(edges, no_vertices);
+        order = relabeling == Relabeling::BFS ? get_bfs_order(edges, degrees)
+                                              : sort_by_degree(degrees, true);
+    }
+
+    std::vector<Vertex_id_t> new_ids(no_vertices);
+    for (size_t i = 0; i < no_vertices; i++)
+        new_ids[order[i]] = i;
+    return new_ids;
+}
+
+void relabel_edges(Raw_edges_list &edges,
+                   const std::vector<Vertex_id_t> &new_ids) {
+    for (auto &[u, v] : edges) {
+        u = new_ids[u];
+        v = new_ids[v];
+    }
+}
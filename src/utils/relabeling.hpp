@@ -0,0 +1,31 @@
+#ifndef RELABELING_HPP
+#define RELABELING_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+
+// Orders in which vertices can be renumbered before running an algorithm,
+// so that vertices close in the graph land close in per-vertex arrays.
+enum class Relabeling {
+    NONE,
+    // Order of a BFS over the underlying undirected graph, starting from
+    // vertices of the lowest degree as in the Cuthill-McKee ordering.
+    BFS,
+    // Decreasing degree, which packs high degree vertices together.
+    DEGREE,
+};
+
+std::optional<Relabeling> parse_relabeling(const std::string &name);
+
+// Returns the new id of every vertex.
+std::vector<Vertex_id_t> compute_relabeling(const Raw_edges_list &edges,
+                                            size_t no_vertices,
+                                            Relabeling relabeling);
+
+void relabel_edges(Raw_edges_list &edges,
+                   const std::vector<Vertex_id_t> &new_ids);
+
+#endif  // RELABELING_HPP
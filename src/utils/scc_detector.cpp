@@ -0,0 +1,67 @@
+#include "scc_detector.hpp"
+
+SccDetector::Local_id_t SccDetector::get_local_id(const VertexPtr &u) {
+    const auto [iter, inserted] = local_ids.try_emplace(u->id, vertices.size());
+    if (inserted) {
+        vertices.push_back(u);
+        if (adjacency_list.size() < vertices.size())
+            adjacency_list.emplace_back();
+        visited.push_back(false);
+        is_in_new_scc.push_back(false);
+    }
+    return iter->second;
+}
+
+void SccDetector::add_edge(const VertexPtr &u, const VertexPtr &v) {
+    const auto u_id = get_local_id(u);
+    const auto v_id = get_local_id(v);
+    adjacency_list[u_id].push_back(v_id);
+}
+
+void SccDetector::dfs(Local_id_t source, Local_id_t target,
+                      std::vector<VertexPtr> &new_scc) {
+    const auto propagate = [this](Local_id_t current, Local_id_t neighbour) {
+        if (is_in_new_scc[neighbour])
+            is_in_new_scc[current] = true;
+    };
+
+    dfs_stack.run(
+        source,
+        [this](Local_id_t current) {
+            visited[current] = true;
+            return std::pair(adjacency_list[current].cbegin(),
+                             adjacency_list[current].cend());
+        },
+        [&](Local_id_t current,
+            auto &neighbour_iter) -> std::optional<Local_id_t> {
+            const auto neighbour = *neighbour_iter++;
+            if (!visited[neighbour])
+                return neighbour;
+            propagate(current, neighbour);
+            return std::nullopt;
+        },
+        propagate,
+        [&](Local_id_t current) {
+            if (current == target)
+                is_in_new_scc[current] = true;
+            if (is_in_new_scc[current])
+                new_scc.emplace_back(vertices[current]);
+        });
+}
+
+void SccDetector::find_new_connected_component(
+    const VertexPtr &source, const VertexPtr &target,
+    std::vector<VertexPtr> &new_scc) {
+    const auto source_id = get_local_id(source);
+    const auto target_id = get_local_id(target);
+    dfs(source_id, target_id, new_scc);
+}
+
+void SccDetector::clear() {
+    for (Local_id_t u_id = 0; u_id < vertices.size(); u_id++)
+        adjacency_list[u_id].clear();
+    local_ids.clear();
+    vertices.clear();
+    visited.clear();
+    is_in_new_scc.clear();
+}
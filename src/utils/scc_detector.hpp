@@ -0,0 +1,43 @@
+#ifndef SCC_DETECTOR_HPP
+#define SCC_DETECTOR_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "iterative_dfs.hpp"
+#include "vertex.hpp"
+
+// Small scratch graph used to determine newly created strongly connected
+// components. Only the vertices that received an edge are stored, each under
+// a local id, so memory and the cost of `clear` depend only on the number of
+// touched vertices.
+class SccDetector {
+   private:
+    using Local_id_t = size_t;
+
+    std::unordered_map<Vertex_id_t, Local_id_t> local_ids;
+    std::vector<VertexPtr> vertices;
+    // Rows are reused between searches to avoid reallocations.
+    std::vector<std::vector<Local_id_t>> adjacency_list;
+    std::vector<bool> visited;
+    std::vector<bool> is_in_new_scc;
+    IterativeDfs<Local_id_t, std::vector<Local_id_t>::const_iterator> dfs_stack;
+
+    Local_id_t get_local_id(const VertexPtr &u);
+
+    void dfs(Local_id_t source, Local_id_t target,
+             std::vector<VertexPtr> &new_scc);
+
+   public:
+    void add_edge(const VertexPtr &u, const VertexPtr &v);
+
+    // Appends to `new_scc` all vertices reachable from `source` from which
+    // `target` is reachable.
+    void find_new_connected_component(const VertexPtr &source,
+                                      const VertexPtr &target,
+                                      std::vector<VertexPtr> &new_scc);
+
+    void clear();
+};
+
+#endif  // SCC_DETECTOR_HPP
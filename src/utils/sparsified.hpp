@@ -0,0 +1,71 @@
+#ifndef SPARSIFIED_HPP
+#define SPARSIFIED_HPP
+
+#include <utility>
+
+#include "algorithm.hpp"
+#include "graph_sparsifier.hpp"
+
+// Some algorithms assume that each vertex has degree O(m / n). This wrapper
+// justifies the assumption for any algorithm: edges are inserted into the
+// sparsified graph G* (see GraphSparsifier) instead of the input graph.
+// The wrapped algorithm is created for the input graph, vertices of G* are
+// appended with `Algorithm::add_vertex` once the sparsifier creates them.
+template <typename Base, typename ForwardSparsifier, typename BackwardSparsifier>
+class Sparsified : public Base {
+   private:
+    ForwardSparsifier graph_sparsifier_forward;
+    BackwardSparsifier graph_sparsifier_backward;
+
+   protected:
+    // The sparsifiers refer to vertices by their ids.
+    bool supports_renumbering() const override { return false; }
+
+   public:
+    template <typename... BaseArgs>
+    Sparsified(size_t original_no_vertices,
+               ForwardSparsifier graph_sparsifier_forward,
+               BaseArgs &&...base_args)
+        : Base(std::forward<BaseArgs>(base_args)...),
+          graph_sparsifier_forward(std::move(graph_sparsifier_forward)),
+          graph_sparsifier_backward(original_no_vertices,
+                                    this->graph_sparsifier_forward) {}
+
+    void run(const Raw_edges_list &edges) override {
+        for (const auto &edge : edges) {
+            graph_sparsifier_forward.increase_edges_no();
+            graph_sparsifier_backward.increase_edges_no();
+
+            const auto [u_id, v_id] = edge;
+            const auto u = this->graph.get_vertex_by_id(u_id);
+            const auto v = this->graph.get_vertex_by_id(v_id);
+
+            graph_sparsifier_forward.generate_new_edges(u);
+            graph_sparsifier_backward.generate_new_edges(v);
+            graph_sparsifier_forward.insert_generated_edge(
+                graph_sparsifier_forward.get_corresponding_id(u),
+                graph_sparsifier_backward.get_corresponding_id(v));
+            while (this->graph.get_no_vertices() <
+                   graph_sparsifier_forward.get_no_vertices())
+                this->add_vertex();
+
+            for (const auto &[w_id, z_id] :
+                 *graph_sparsifier_forward.get_generated_edges()) {
+                this->process_edge(this->graph.get_vertex_by_id(w_id),
+                                   this->graph.get_vertex_by_id(z_id));
+            }
+
+            graph_sparsifier_forward.clear_generated_edges();
+        }
+    }
+};
+
+template <typename Base>
+using SimpleSparsified = Sparsified<Base, SimpleGraphSparsifierForward,
+                                   SimpleGraphSparsifierBackward>;
+
+template <typename Base>
+using AdvancedSparsified = Sparsified<Base, AdvancedGraphSparsifierForward,
+                                      AdvancedGraphSparsifierBackward>;
+
+#endif  // SPARSIFIED_HPP
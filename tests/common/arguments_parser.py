@@ -22,8 +22,10 @@ def get_arg_parser(default_algorithms, default_test_dir):
     return parser
 
 
-def get_args(default_test_dir):
-    parser = get_arg_parser(ALGORITHMS, default_test_dir)
+# `parser` can be given to extend the common arguments.
+def get_args(default_test_dir, parser=None):
+    if parser is None:
+        parser = get_arg_parser(ALGORITHMS, default_test_dir)
     args = parser.parse_args()
     if args.algorithms is not None:
         for algorithm in args.algorithms:
@@ -227,6 +227,21 @@ class MixedDegrees(Graph):
         return self._shuffled_edges(edges)
 
 
+class LongCycle(Graph):
+    """
+    Path 0 -> 1 -> ... -> n - 1 inserted in order and closed into a cycle
+    by the last edge, which merges all vertices into a single component.
+    """
+
+    def __init__(self, n):
+        super().__init__(n, n)
+
+    def _generate_edges(self):
+        edges = [(u, u + 1) for u in range(self.n - 1)]
+        edges.append((self.n - 1, 0))
+        return edges
+
+
 # The class of graphs described in https://arxiv.org/pdf/1105.2397 as an example
 # where CompatibleSearch and SoftThresholdSearch perform a large number of operations.
 class PathsCollection(Graph):
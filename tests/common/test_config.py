@@ -13,10 +13,28 @@ ALGORITHMS = [
     "topological_search",
     "sample_search",
     "sparsified_sample_search",
+    "advanced_sparsified_sample_search",
+    "sparsified_two_way_search",
+    "advanced_sparsified_two_way_search",
+    "sparsified_compatible_search",
+    "advanced_sparsified_compatible_search",
+    "sparsified_soft_threshold_search",
+    "advanced_sparsified_soft_threshold_search",
+    "bernstein_chechik_search",
+    "pearce_kelly_search",
 ]
 
 GROUND_TRUTH = "naive_dfs"
 
+# Flags of main which change how edges are processed. Correctness tests make
+# a separate pass over all cases with each set.
+CORRECTNESS_FLAG_SETS = {
+    "default": [],
+    "prefilter": ["--prefilter"],
+    "dedup": ["--dedup", "--drop-same-scc"],
+    "compressed": ["--compressed"],
+}
+
 CACHE_FILENAME = ".perf_cache.json"
 
 CORRECTNESS_TEST_DIR = "tests/correctness/test_cases"
@@ -1,22 +1,30 @@
 import subprocess
 import os
+import shlex
 import sys
 
 from tests.common import common, arguments_parser
-from tests.common.test_config import CORRECTNESS_TEST_DIR, EXECUTABLE
+from tests.common.test_config import (
+    ALGORITHMS,
+    CORRECTNESS_FLAG_SETS,
+    CORRECTNESS_TEST_DIR,
+    EXECUTABLE,
+)
 
 GEN_SCRIPT = "tests/correctness/generate_tests.py"
 
 
-def run_algorithm(algorithm, test_file):
+def run_algorithm(algorithm, test_file, flags):
     try:
-        result = subprocess.check_output([EXECUTABLE, algorithm, test_file], text=True)
+        result = subprocess.check_output(
+            [EXECUTABLE, algorithm, test_file, *flags], text=True
+        )
         return result.strip()
     except subprocess.CalledProcessError as e:
         return f"[ERROR] {e}"
 
 
-def run_tests(test_dir, algorithms):
+def run_tests(test_dir, algorithms, flags):
     in_dir = common.get_ins_directory(test_dir)
     out_dir = common.get_outs_directory(test_dir)
     common.assure_directory_exists(in_dir)
@@ -32,11 +40,13 @@ def run_tests(test_dir, algorithms):
             expected = out_file.read().strip()
 
         for algorithm in algorithms:
-            result = run_algorithm(algorithm, in_path)
+            result = run_algorithm(algorithm, in_path, flags)
             if result == expected:
                 passed += 1
             else:
-                sys.stdout.write(f"\n[FAIL] {algorithm} on {test_file}\n")
+                sys.stdout.write(
+                    f"\n[FAIL] {algorithm} {shlex.join(flags)} on {test_file}\n"
+                )
                 sys.stdout.flush()
 
         sys.stdout.write(f"\rProgress: {i}/{total} cases.")
@@ -49,15 +59,35 @@ def run_tests(test_dir, algorithms):
         print("Some errors occurred.")
 
 
+def get_args():
+    parser = arguments_parser.get_arg_parser(ALGORITHMS, CORRECTNESS_TEST_DIR)
+    parser.add_argument(
+        "--flag-sets",
+        nargs="+",
+        choices=CORRECTNESS_FLAG_SETS.keys(),
+        default=list(CORRECTNESS_FLAG_SETS.keys()),
+        help="Sets of flags to run the tests with, all by default.",
+    )
+    parser.add_argument(
+        "--extra-args",
+        default="",
+        help="Flags passed to every run, e.g. --extra-args='--sample-size=4'.",
+    )
+    return arguments_parser.get_args(CORRECTNESS_TEST_DIR, parser)
+
+
 def main():
-    args = arguments_parser.get_args(CORRECTNESS_TEST_DIR)
+    args = get_args()
 
     if args.generate_tests:
         subprocess.run(["python3", GEN_SCRIPT], check=True)
         return
 
     algorithms = args.algorithms or args.default_algorithms
-    run_tests(args.test_dir, algorithms)
+    for flag_set in args.flag_sets:
+        flags = CORRECTNESS_FLAG_SETS[flag_set] + shlex.split(args.extra_args)
+        print(f"=== {flag_set}: {shlex.join(flags) or 'no flags'} ===")
+        run_tests(args.test_dir, algorithms, flags)
 
 
 if __name__ == "__main__":
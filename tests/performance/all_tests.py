@@ -6,14 +6,22 @@ from tests.common.graph import (
     MixedDegrees,
     PathsCollection,
     CliquesCollection,
+    LongCycle,
 )
 from tests.common.common import write_case_in
 
+# Sparsification only pays off on graphs with high-degree hubs.
+SPARSIFIED_ALGS = [
+    alg
+    for alg in ALGORITHMS
+    if "sparsified_" in alg and alg != "sparsified_sample_search"
+]
 DEFAULT_ALGS = [
     alg
     for alg in ALGORITHMS
     if alg != "soft_threshold_search_basic_list"
     and alg != "soft_threshold_search_treap"
+    and alg not in SPARSIFIED_ALGS
 ]
 NON_TRIVIAL_ALGS = [alg for alg in DEFAULT_ALGS if alg != "naive_dfs"]
 FASTEST_ALGS = [
@@ -22,13 +30,16 @@ FASTEST_ALGS = [
     "soft_threshold_search",
     "sparsified_sample_search",
     "sample_search",
+    "bernstein_chechik_search",
 ]
 FASTEST_ALGS_WITHOUT_SAMPLE = [
     alg
     for alg in FASTEST_ALGS
-    if alg != "sample_search" and alg != "sparsified_sample_search"
+    if alg != "sample_search"
+    and alg != "sparsified_sample_search"
+    and alg != "bernstein_chechik_search"
 ]
-OPTIMAL_MEMORY_ALGS = [alg for alg in DEFAULT_ALGS if alg != "topological_search"]
+OPTIMAL_MEMORY_ALGS = DEFAULT_ALGS
 SEMIFAST_OPTIMAL_MEMORY_ALGS = [
     alg for alg in OPTIMAL_MEMORY_ALGS if alg != "naive_dfs"
 ]
@@ -40,12 +51,29 @@ SPARSE_DAG_ALGS = [
     alg for alg in SEMIFAST_OPTIMAL_MEMORY_ALGS if alg != "two_way_search"
 ]
 SPARSE_DAG_NARROWED_ALGS = [alg for alg in SPARSE_DAG_ALGS if alg != "limited_search"]
-MIXED_DEGREES_ALGS = [alg for alg in FASTEST_ALGS if alg != "sample_search"]
+# TopologicalSearch doesn't finish random_almost_dag_1 within 15 minutes.
+ALMOST_DAG_ENHANCED_ALGS = [
+    alg for alg in SEMIFAST_OPTIMAL_MEMORY_ALGS if alg != "topological_search"
+]
+ALMOST_DAG_ALGS = [alg for alg in SPARSE_DAG_ALGS if alg != "topological_search"]
+ALMOST_DAG_NARROWED_ALGS = [
+    alg for alg in SPARSE_DAG_NARROWED_ALGS if alg != "topological_search"
+]
+# BernsteinChechikSearch takes about 4 minutes on mixed_degrees_1.
+MIXED_DEGREES_ENHANCED_ALGS = [
+    alg for alg in FASTEST_ALGS if alg != "bernstein_chechik_search"
+]
+MIXED_DEGREES_ALGS = [
+    alg for alg in MIXED_DEGREES_ENHANCED_ALGS if alg != "sample_search"
+] + SPARSIFIED_ALGS
 PATHS_COLLECTION_ENHANCED_ALGS = [
     alg for alg in SEMIFAST_OPTIMAL_MEMORY_ALGS if alg != "naive_one_way_search"
 ]
+# TopologicalSearch takes about 15 minutes on paths_collection_5.
 PATHS_COLLECTION_ALGS = [
-    alg for alg in PATHS_COLLECTION_ENHANCED_ALGS if alg != "limited_search"
+    alg
+    for alg in PATHS_COLLECTION_ENHANCED_ALGS
+    if alg != "limited_search" and alg != "topological_search"
 ]
 CLIQUES_COLLECTION_ALGS = FASTEST_ALGS + ["limited_search"]
 
@@ -76,7 +104,8 @@ _TESTS_TO_GENERATE = [
     (
         RandomGraph(70000, 140000, 23),
         "random_small_sparse_graph_4",
-        FASTEST_ALGS + ["one_way_search", "naive_one_way_search"],
+        FASTEST_ALGS
+        + ["one_way_search", "naive_one_way_search", "topological_search"],
     ),
     (RandomGraph(300000, 600000, 30), "random_sparse_graph_1", FASTEST_ALGS),
     (RandomGraph(500000, 1000000, 31), "random_sparse_graph_2", FASTEST_ALGS),
@@ -107,26 +136,34 @@ _TESTS_TO_GENERATE = [
     (
         RandomAlmostDAG(400000, 2400000, 50, 60),
         "random_almost_dag_1",
-        SEMIFAST_OPTIMAL_MEMORY_ALGS,
+        ALMOST_DAG_ENHANCED_ALGS,
     ),
     (
         RandomAlmostDAG(600000, 3600000, 50, 61),
         "random_almost_dag_2",
-        SEMIFAST_OPTIMAL_MEMORY_ALGS,
+        ALMOST_DAG_ENHANCED_ALGS,
     ),
-    (RandomAlmostDAG(800000, 4800000, 50, 62), "random_almost_dag_3", SPARSE_DAG_ALGS),
+    (RandomAlmostDAG(800000, 4800000, 50, 62), "random_almost_dag_3", ALMOST_DAG_ALGS),
     (
         RandomAlmostDAG(1000000, 6000000, 50, 63),
         "random_almost_dag_4",
-        SPARSE_DAG_NARROWED_ALGS,
+        ALMOST_DAG_NARROWED_ALGS,
     ),
     (
         RandomAlmostDAG(1200000, 7200000, 50, 64),
         "random_almost_dag_5",
-        SPARSE_DAG_NARROWED_ALGS,
+        ALMOST_DAG_NARROWED_ALGS,
+    ),
+    (
+        MixedDegrees(400000, 1200000, 1000, 400, 70),
+        "mixed_degrees_1",
+        MIXED_DEGREES_ENHANCED_ALGS,
+    ),
+    (
+        MixedDegrees(600000, 1800000, 1000, 400, 71),
+        "mixed_degrees_2",
+        MIXED_DEGREES_ENHANCED_ALGS,
     ),
-    (MixedDegrees(400000, 1200000, 1000, 400, 70), "mixed_degrees_1", FASTEST_ALGS),
-    (MixedDegrees(600000, 1800000, 1000, 400, 71), "mixed_degrees_2", FASTEST_ALGS),
     (
         MixedDegrees(800000, 2400000, 1000, 400, 72),
         "mixed_degrees_3",
@@ -147,6 +184,8 @@ _TESTS_TO_GENERATE = [
         "mixed_degrees_6",
         MIXED_DEGREES_ALGS,
     ),
+    (LongCycle(300000), "long_cycle_1", FASTEST_ALGS, False),
+    (LongCycle(1000000), "long_cycle_2", FASTEST_ALGS, False),
     (
         PathsCollection(200, 500),
         "paths_collection_1",
@@ -200,7 +239,13 @@ _REAL_LIFE_TESTS = [
     (None, "road_network_pennsylvania", SEMIFAST_OPTIMAL_MEMORY_ALGS),
     (None, "road_network_texas", SEMIFAST_OPTIMAL_MEMORY_ALGS),
     (None, "wikipedia_talk", FASTEST_ALGS),
-    (None, "twitter", FASTEST_ALGS + ["naive_one_way_search", "one_way_search"]),
+    (
+        None,
+        "twitter",
+        FASTEST_ALGS
+        + SPARSIFIED_ALGS
+        + ["naive_one_way_search", "one_way_search"],
+    ),
     (None, "google_plus", FASTEST_ALGS),
     (None, "live_journal", FASTEST_ALGS_WITHOUT_SAMPLE),
     (None, "mathoverflow", SEMIFAST_OPTIMAL_MEMORY_ALGS),
@@ -0,0 +1,49 @@
+"""
+Helpers shared by scripts benchmarking variants of a single algorithm.
+Measures both the wall-clock time and the peak memory usage of a run.
+"""
+
+import os
+import subprocess
+import sys
+import time
+
+from tests.common.test_config import EXECUTABLE, PERFORMANCE_TEST_DIR
+from tests.common.common import get_ins_directory
+
+
+def get_test_path(test_name, test_dir=PERFORMANCE_TEST_DIR):
+    path = os.path.join(get_ins_directory(test_dir), test_name + ".in")
+    if not os.path.exists(path):
+        print(
+            f'Error: test "{test_name}" does not exist. Perhaps you forgot to generate the tests using "--generate" flag.',
+            file=sys.stderr,
+        )
+        sys.exit(1)
+    return path
+
+
+# Returns the elapsed time in seconds and the maximum resident set size in KB.
+def run_once(algorithm, test_file, extra_args=(), executable=EXECUTABLE):
+    args = [executable, algorithm, test_file, *extra_args]
+    start_time = time.perf_counter()
+    process = subprocess.Popen(
+        args, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL
+    )
+    _, status, usage = os.wait4(process.pid, 0)
+    elapsed = time.perf_counter() - start_time
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        raise RuntimeError(f"{' '.join(args)} exited with {process.returncode}")
+    return elapsed, usage.ru_maxrss
+
+
+# Returns the average time and the maximum resident set size over `runs` runs.
+def measure(algorithm, test_file, extra_args=(), executable=EXECUTABLE, runs=3):
+    total_time = 0.0
+    max_rss = 0
+    for _ in range(runs):
+        elapsed, rss = run_once(algorithm, test_file, extra_args, executable)
+        total_time += elapsed
+        max_rss = max(max_rss, rss)
+    return total_time / runs, max_rss
@@ -0,0 +1,72 @@
+"""
+Compares running times of two builds of the project on selected tests, e.g.
+to check whether a change of the memory layout pays off. The baseline can be
+built from any revision:
+    git worktree add /tmp/baseline <revision> && make -C /tmp/baseline
+Flags given with `--candidate-args` are passed only to the candidate, so
+a single build can also be compared with and without them.
+"""
+
+import argparse
+
+from tests.common.test_config import EXECUTABLE, PERFORMANCE_TEST_DIR
+from tests.performance.benchmark import get_test_path, measure
+
+DEFAULT_TESTS = [
+    "random_sparse_graph_1",
+    "random_sparse_graph_2",
+    "road_network_california",
+    "road_network_pennsylvania",
+    "road_network_texas",
+]
+DEFAULT_ALGORITHMS = ["two_way_search", "pearce_kelly_search"]
+
+
+def get_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--baseline", default=EXECUTABLE, help="baseline executable"
+    )
+    parser.add_argument("--candidate", default=EXECUTABLE)
+    parser.add_argument(
+        "--candidate-args",
+        default="",
+        help='flags of the candidate, e.g. --candidate-args="--relabel=bfs"',
+    )
+    parser.add_argument("--tests", nargs="+", default=DEFAULT_TESTS)
+    parser.add_argument("--test-dir", default=PERFORMANCE_TEST_DIR)
+    parser.add_argument("--algorithms", nargs="+", default=DEFAULT_ALGORITHMS)
+    parser.add_argument("--runs", type=int, default=3)
+    return parser.parse_args()
+
+
+def main():
+    args = get_args()
+    print(
+        f"{'Test':<28} {'Algorithm':<24} {'Baseline (s)':>12} "
+        f"{'Candidate (s)':>13} {'Speedup':>8} {'Max RSS (MB)':>14}"
+    )
+    print("-" * 104)
+    for test_name in args.tests:
+        test_path = get_test_path(test_name, args.test_dir)
+        for algorithm in args.algorithms:
+            baseline_time, baseline_rss = measure(
+                algorithm, test_path, executable=args.baseline, runs=args.runs
+            )
+            candidate_time, candidate_rss = measure(
+                algorithm,
+                test_path,
+                args.candidate_args.split(),
+                executable=args.candidate,
+                runs=args.runs,
+            )
+            rss = f"{baseline_rss / 1024:.1f} -> {candidate_rss / 1024:.1f}"
+            print(
+                f"{test_name:<28} {algorithm:<24} {baseline_time:>12.4f} "
+                f"{candidate_time:>13.4f} {baseline_time / candidate_time:>8.2f} "
+                f"{rss:>14}"
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,49 @@
+"""
+Compares running time and memory usage of algorithms with plain and compressed
+adjacency lists (`--compressed`). Prints a table for each test.
+"""
+
+import argparse
+
+from tests.performance.benchmark import get_test_path, measure
+
+DEFAULT_TESTS = ["live_journal", "stackoverflow"]
+DEFAULT_ALGORITHMS = ["two_way_search", "soft_threshold_search"]
+
+
+def get_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--tests", nargs="+", default=DEFAULT_TESTS)
+    parser.add_argument("--algorithms", nargs="+", default=DEFAULT_ALGORITHMS)
+    parser.add_argument("--runs", type=int, default=3)
+    return parser.parse_args()
+
+
+def main():
+    args = get_args()
+    for test_name in args.tests:
+        test_path = get_test_path(test_name)
+        print(test_name)
+        print("=" * len(test_name))
+        print(
+            f"{'Algorithm':<28} {'Time (s)':>10} {'Compressed':>11} "
+            f"{'Max RSS (MB)':>13} {'Compressed':>11}"
+        )
+        print("-" * 77)
+
+        for algorithm in args.algorithms:
+            plain_time, plain_rss = measure(
+                algorithm, test_path, [], runs=args.runs
+            )
+            compressed_time, compressed_rss = measure(
+                algorithm, test_path, ["--compressed"], runs=args.runs
+            )
+            print(
+                f"{algorithm:<28} {plain_time:>10.4f} {compressed_time:>11.4f} "
+                f"{plain_rss / 1024:>13.1f} {compressed_rss / 1024:>11.1f}"
+            )
+        print()
+
+
+if __name__ == "__main__":
+    main()
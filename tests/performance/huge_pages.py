@@ -0,0 +1,83 @@
+"""
+Compares running times of algorithms with and without huge pages
+(`--huge-pages`). On Linux with `perf` installed, also reports the number of
+dTLB misses of both runs. Prints a table for each test.
+"""
+
+import argparse
+import shutil
+import subprocess
+
+from tests.common.test_config import EXECUTABLE
+from tests.performance.benchmark import get_test_path, measure
+
+DEFAULT_TESTS = ["random_sparse_graph_7", "road_network_texas"]
+DEFAULT_ALGORITHMS = ["two_way_search", "pearce_kelly_search"]
+TLB_EVENTS = "dTLB-load-misses,dTLB-store-misses"
+
+
+def get_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--tests", nargs="+", default=DEFAULT_TESTS)
+    parser.add_argument("--algorithms", nargs="+", default=DEFAULT_ALGORITHMS)
+    parser.add_argument("--runs", type=int, default=3)
+    return parser.parse_args()
+
+
+# Returns the total number of dTLB misses of a single run, or None if they
+# can't be counted.
+def count_tlb_misses(algorithm, test_path, extra_args):
+    if shutil.which("perf") is None:
+        return None
+    result = subprocess.run(
+        ["perf", "stat", "-x", ",", "-e", TLB_EVENTS, EXECUTABLE, algorithm]
+        + [test_path, *extra_args],
+        stdout=subprocess.DEVNULL,
+        stderr=subprocess.PIPE,
+        text=True,
+    )
+    total = 0
+    for line in result.stderr.splitlines():
+        value = line.split(",")[0]
+        if not value.isdigit():
+            return None
+        total += int(value)
+    return total
+
+
+def format_misses(misses):
+    return "n/a" if misses is None else f"{misses / 1e6:.1f}M"
+
+
+def main():
+    args = get_args()
+    for test_name in args.tests:
+        test_path = get_test_path(test_name)
+        print(test_name)
+        print("=" * len(test_name))
+        print(
+            f"{'Algorithm':<28} {'Time (s)':>10} {'Huge pages':>11} "
+            f"{'Speedup':>8} {'dTLB misses':>12} {'Huge pages':>11}"
+        )
+        print("-" * 85)
+
+        for algorithm in args.algorithms:
+            plain_time, _ = measure(algorithm, test_path, [], runs=args.runs)
+            huge_time, _ = measure(
+                algorithm, test_path, ["--huge-pages"], runs=args.runs
+            )
+            plain_misses = count_tlb_misses(algorithm, test_path, [])
+            huge_misses = count_tlb_misses(
+                algorithm, test_path, ["--huge-pages"]
+            )
+            print(
+                f"{algorithm:<28} {plain_time:>10.4f} {huge_time:>11.4f} "
+                f"{plain_time / huge_time:>8.2f} "
+                f"{format_misses(plain_misses):>12} "
+                f"{format_misses(huge_misses):>11}"
+            )
+        print()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+"""
+Measures how the sample size of SampleSearch influences its running time.
+Prints a table for each test and saves a chart with one curve per test.
+"""
+
+import argparse
+import os
+
+from tests.performance.benchmark import get_test_path, measure
+
+OUTPUT_DIR = "charts"
+
+DEFAULT_TESTS = ["random_sparse_graph_1", "random_dense_dag_1", "twitter"]
+DEFAULT_SIZES = ["2", "4", "8", "16", "32", "64", "128", "256", "auto"]
+
+
+def get_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--tests", nargs="+", default=DEFAULT_TESTS)
+    parser.add_argument("--sizes", nargs="+", default=DEFAULT_SIZES)
+    parser.add_argument(
+        "--algorithm",
+        default="sample_search",
+        choices=["sample_search", "sparsified_sample_search"],
+    )
+    parser.add_argument("--runs", type=int, default=3)
+    parser.add_argument("--no-chart", action="store_true")
+    return parser.parse_args()
+
+
+def draw_chart(results, sizes, algorithm):
+    import matplotlib.pyplot as plt
+
+    x_positions = list(range(len(sizes)))
+    plt.figure(figsize=(10, 5))
+    for test_name, times in results.items():
+        plt.plot(x_positions, times, marker="o", label=test_name)
+
+    plt.xlabel("Sample size")
+    plt.ylabel("Time (seconds)")
+    plt.xticks(x_positions, sizes)
+    plt.legend()
+    plt.grid(True)
+    plt.tight_layout()
+
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    out_file = os.path.join(OUTPUT_DIR, f"{algorithm}_sample_size.pdf")
+    plt.savefig(out_file, bbox_inches="tight")
+    print(f"Saved chart to {out_file}")
+
+
+def main():
+    args = get_args()
+    results = {}
+    for test_name in args.tests:
+        test_path = get_test_path(test_name)
+        print(test_name)
+        print("=" * len(test_name))
+        print(f"{'Sample size':<12} {'Time (s)':>10} {'Max RSS (MB)':>14}")
+        print("-" * 38)
+
+        results[test_name] = []
+        for size in args.sizes:
+            elapsed, rss = measure(
+                args.algorithm, test_path, [f"--sample-size={size}"], runs=args.runs
+            )
+            results[test_name].append(elapsed)
+            print(f"{size:<12} {elapsed:>10.4f} {rss / 1024:>14.1f}")
+        print()
+
+    if not args.no_chart:
+        draw_chart(results, args.sizes, args.algorithm)
+
+
+if __name__ == "__main__":
+    main()